@@ -0,0 +1,99 @@
+/**
+    @file include/allocation_policy.h
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief The definition of the car allocation policies.
+
+    A policy decides which of the cars in the pool of a station is
+    attached to a train that is being assembled. Policies hold no
+    state of their own, so one policy can be shared by every run of a
+    sweep or a scenario batch.
+*/
+#ifndef INCLUDE_ALLOCATION_POLICY_H
+#define INCLUDE_ALLOCATION_POLICY_H
+
+#include "time_point.h"
+#include "train.h"
+#include "vehicle.h"
+#include "vehicle_type.h"
+#include <memory>  // shared_ptr
+#include <string>
+#include <vector>
+
+namespace pabo::train {
+
+class Station;
+class TrainDispatcher;
+
+// A train asks for one car of a type that is available in the pool of
+// its origin station.
+struct AllocationRequest {
+    const Train& train;
+    Vehicle::Type type;
+    const Station& station;
+    const TrainDispatcher& dispatcher;
+};
+
+class AllocationPolicy {
+public:
+    using CarView = const Vehicle*;
+
+    virtual ~AllocationPolicy() = default;
+
+    [[nodiscard]] virtual std::string name() const = 0;
+
+    // Returns one of the cars of the requested type in the pool, or
+    // nullptr to leave the slot empty until the next attempt.
+    [[nodiscard]] virtual CarView choose(const AllocationRequest&) const = 0;
+
+    // False if the choices depend on the history of the run in a way
+    // that a rollback of the optimistic execution mode does not undo.
+    [[nodiscard]] virtual bool supportsRollback() const noexcept;
+};
+
+// The car with the lowest id.
+class LowestIdPolicy : public AllocationPolicy {
+public:
+    [[nodiscard]] std::string name() const override;
+    [[nodiscard]] CarView choose(const AllocationRequest&) const override;
+};
+
+// The fastest locomotive, other cars by lowest id.
+class FastestFirstPolicy : public AllocationPolicy {
+public:
+    [[nodiscard]] std::string name() const override;
+    [[nodiscard]] CarView choose(const AllocationRequest&) const override;
+};
+
+// The car that has been attached to the fewest trains, to spread the
+// wear over the fleet.
+class LeastUsedPolicy : public AllocationPolicy {
+public:
+    [[nodiscard]] std::string name() const override;
+    [[nodiscard]] CarView choose(const AllocationRequest&) const override;
+    [[nodiscard]] bool supportsRollback() const noexcept override;
+};
+
+// Scarce cars are held back from a train that can not be completed
+// anyway when they would complete another train that is scheduled to
+// depart from the same station within the horizon after it.
+class LookaheadPolicy : public AllocationPolicy {
+public:
+    explicit LookaheadPolicy(time::TimeOfDay horizon = time::TimeOfDay{"02:00"});
+
+    [[nodiscard]] std::string name() const override;
+    [[nodiscard]] CarView choose(const AllocationRequest&) const override;
+
+private:
+    time::TimeOfDay m_horizon;
+};
+
+// Returns the policy with the given name, one of the names returned by
+// allocationPolicyNames. Throws invalid_argument if there is none.
+[[nodiscard]] std::shared_ptr<const AllocationPolicy> makeAllocationPolicy(const std::string& name);
+[[nodiscard]] std::vector<std::string> allocationPolicyNames();
+
+}  // namespace pabo::train
+
+#endif
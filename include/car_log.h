@@ -9,33 +9,50 @@
 #define INCLUDE_CAR_LOG_H
 
 
+#include "small_vector.h"
+#include "span.h"
+#include "station_id.h"
 #include "time_point.h"
 #include "train.h"
-#include <string>
-#include <unordered_map>
+#include <cstdint>  // int32_t
 #include <vector>
 
 namespace pabo::train {
 
+// One arrival of a car. The train number of a car that was moved
+// empty is 0.
 struct CarRecord {
-    CarRecord(time::TimeOfDay tod, int trainNbr, std::string stationName);
+    [[nodiscard]] time::TimeOfDay time() const;
 
-    time::TimeOfDay time;
-    int trainNbr;
-    std::string destination;
+    std::int32_t rawTime;
+    std::int32_t trainNbr;
+    StationId destination;
 };
 
 class CarLog {
 public:
+    using History = Span<const CarRecord>;
+
     // Logs the arrival of each car in the train.
-    void logArrival(time::TimeOfDay tod, const Train& t, const std::string& stationName);
-    // Returns a
-    std::vector<CarRecord> viewRecordOf(int id);
+    void logArrival(time::TimeOfDay tod, const Train& t, StationId station);
+    // Logs the arrival of cars that were moved empty.
+    void logTransfer(time::TimeOfDay tod, const std::vector<int>& ids, StationId station);
+    // Returns the arrivals of a car in time order. Throws out_of_range
+    // if the car has never arrived anywhere. The view is valid until the
+    // log is next modified.
+    [[nodiscard]] History viewRecordOf(int id) const;
+
+    // Move all records of another log into this log.
+    void merge(CarLog other);
 
 private:
-    void sort();
+    // Car histories rarely exceed a handful of arrivals per day.
+    static constexpr std::size_t inlineRecords{4};
+
+    [[nodiscard]] SmallVector<CarRecord, inlineRecords>& historyOf(int id);
 
-    std::unordered_map<int, std::vector<CarRecord>> m_history;
+    // Indexed by car id.
+    std::vector<SmallVector<CarRecord, inlineRecords>> m_history;
 };
 
 }  // namespace pabo::train
@@ -0,0 +1,74 @@
+/**
+    @file include/departure_board.h
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief The definition of the DepartureBoard class.
+
+    The next departures from a station, as a board on the platform
+    shows them. The board keeps the rows that it shows and the change
+    count of each train, see TrainDispatcher::changeCount, so a refresh
+    only recomputes the rows of the trains that have changed since the
+    last one. A train leaves the board when it departs and the next
+    departure in the timetable takes its place, so a refresh costs the
+    number of rows and not the number of trains.
+*/
+#ifndef INCLUDE_DEPARTURE_BOARD_H
+#define INCLUDE_DEPARTURE_BOARD_H
+
+#include "station_id.h"
+#include "time_point.h"
+#include "timetable.h"
+#include "train.h"
+#include <cstddef>  // size_t
+#include <vector>
+
+namespace pabo::train {
+
+class TrainDispatcher;
+
+class DepartureBoard {
+public:
+    struct Row {
+        int trainNbr;
+        StationId destination;
+        time::TimeOfDay scheduled;
+        time::TimeOfDay estimated;
+        time::TimeOfDay delay;
+        Train::State state;
+    };
+
+    // Throws invalid_argument if the board has no rows.
+    DepartureBoard(const TrainDispatcher& disp, StationId id, std::size_t rows = 10);
+
+    // Updates the rows to the state of the dispatcher. Returns the
+    // number of rows that were recomputed.
+    std::size_t refresh();
+    // Empties the board, for a simulation that starts over.
+    void reset() noexcept;
+
+    [[nodiscard]] StationId station() const noexcept;
+    // The trains that have not departed, in the order of the timetable.
+    [[nodiscard]] std::vector<Row> rows() const;
+
+private:
+    struct Slot {
+        Timetable::Entry entry;
+        unsigned changes;
+        Row row;
+    };
+
+    [[nodiscard]] Slot makeSlot(const Timetable::Entry& entry) const;
+
+    const TrainDispatcher* m_disp;
+    StationId m_station;
+    std::size_t m_rows;
+    std::vector<Slot> m_slots;
+    // The position in the departures of the station after the last
+    // departure that was put on the board.
+    std::size_t m_next{0};
+};
+
+}  // namespace pabo::train
+
+#endif
@@ -0,0 +1,87 @@
+/**
+    @file include/event_batch.h
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief The definition of the EventBatch class.
+
+    The events that share a timestamp, split into groups by the
+    station where they take place. Every train has at most one pending
+    event, so the groups touch disjoint trains and stations and are
+    processed in parallel. Within a group the events are processed in
+    the same order as in the sequential mode.
+*/
+#ifndef INCLUDE_EVENT_BATCH_H
+#define INCLUDE_EVENT_BATCH_H
+
+#include "car_log.h"
+#include "event.h"
+#include "event_hooks.h"
+#include "event_sites.h"
+#include "time_point.h"
+#include "train_log.h"
+#include <cstddef>  // size_t
+#include <memory>  // shared_ptr
+#include <queue>
+#include <vector>
+
+namespace pabo::train {
+class TrainDispatcher;
+}
+
+namespace pabo::app {
+
+class ThreadPool;
+
+class EventBatch {
+public:
+    using EventPtr = std::shared_ptr<train::Event>;
+
+    EventBatch(const train::TrainDispatcher& disp, const EventHooks& hooks);
+
+    // Adds an event to the batch. Every event in a batch must have
+    // the same time.
+    // Throws logic_error if the event belongs to no station.
+    void add(EventPtr event);
+
+    [[nodiscard]] bool isEmpty() const noexcept;
+
+    // Called by the events of the batch. Events at the time of the
+    // batch are processed in the batch, the others are kept for the
+    // caller.
+    void schedule(EventPtr event);
+
+    // Processes every event of the batch, each group as one task in
+    // the pool, and logs to the logs in a deterministic order.
+    void run(ThreadPool& pool, train::TrainLog& log, train::CarLog& carLog);
+
+    // Returns the events scheduled later than the batch.
+    [[nodiscard]] std::vector<EventPtr> takeScheduled();
+
+    // Returns the number of high priority events processed since the
+    // last call.
+    [[nodiscard]] int takeHighPriorityCount();
+
+private:
+    struct Group {
+        std::priority_queue<EventPtr, std::vector<EventPtr>, train::EventComparison> queue;
+        std::vector<EventPtr> scheduled;
+        train::TrainLog log;
+        train::CarLog carLog;
+        int highPriorityCount{0};
+    };
+
+    void runGroup(Group& g) const;
+
+    static thread_local Group* s_currentGroup;
+
+    const EventHooks& m_hooks;
+    EventSites m_sites;
+    std::vector<Group> m_groups;
+    std::vector<std::size_t> m_active;
+    time::TimeOfDay m_time{0};
+};
+
+}  // namespace pabo::app
+
+#endif
@@ -0,0 +1,63 @@
+/**
+    @file include/event_hooks.h
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief The definition of the EventHooks class.
+
+    The observers of the simulator, and the one place where an event
+    is processed, in every execution mode. Without observers an event
+    is processed directly, the only cost is the check for observers.
+*/
+#ifndef INCLUDE_EVENT_HOOKS_H
+#define INCLUDE_EVENT_HOOKS_H
+
+#include "event.h"
+#include "event_observer.h"
+#include <vector>
+
+namespace pabo::train {
+class CarLog;
+class TrainLog;
+}
+
+namespace pabo::app {
+
+class EventHooks {
+public:
+    // The observer must outlive the hooks, or be removed.
+    void add(EventObserver& observer);
+    void remove(const EventObserver& observer) noexcept;
+    void clear() noexcept;
+    [[nodiscard]] bool isEmpty() const noexcept;
+
+    void schedule(const train::Event& event) const
+    {
+        if (!m_observers.empty()) {
+            notifyScheduled(event);
+        }
+    }
+
+    // Processes the event between the calls to the observers, in the
+    // order that they were added.
+    void process(train::Event& event, train::TrainLog& log, train::CarLog& carLog) const
+    {
+        if (m_observers.empty()) {
+            event.processEvent(log, carLog);
+        }
+        else {
+            processObserved(event, log, carLog);
+        }
+    }
+
+private:
+    void notifyScheduled(const train::Event& event) const;
+    void processObserved(train::Event& event, train::TrainLog& log,
+                         train::CarLog& carLog) const;
+
+    std::vector<EventObserver*> m_observers;
+};
+
+}  // namespace pabo::app
+
+#endif
@@ -0,0 +1,75 @@
+/**
+    @file include/event_metrics.h
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief The definition of the EventMetrics class.
+
+    An observer of the simulator that measures where a run spends its
+    time: the number of events and a histogram of the wall-clock time
+    to process them per event type, the events and the peak number of
+    pending events per simulated hour, and the events that a train
+    processed more than once, its retries. Every count is atomic, so
+    the metrics are kept in every execution mode. In the optimistic
+    mode the events that were rolled back are counted as well, they
+    show up as retries.
+*/
+#ifndef INCLUDE_EVENT_METRICS_H
+#define INCLUDE_EVENT_METRICS_H
+
+#include "event_observer.h"
+#include "event_type.h"
+#include "latency_histogram.h"
+#include <array>
+#include <atomic>
+#include <cstddef>  // size_t
+#include <cstdint>  // uint64_t
+#include <iosfwd>  // ostream
+#include <utility>  // pair
+#include <vector>
+
+namespace pabo::app {
+
+class EventMetrics : public EventObserver {
+public:
+    // The retries of the trains numbered up to the highest one are
+    // kept. Throws invalid_argument if it is negative.
+    explicit EventMetrics(int highestTrainNbr);
+
+    void eventScheduled(const EventNotice& notice) override;
+    void beforeEvent(const EventNotice& notice) override;
+    void afterEvent(const EventNotice& notice) override;
+
+    [[nodiscard]] const LatencyHistogram& latency(train::EventType type) const;
+    [[nodiscard]] std::uint64_t eventCount() const noexcept;
+    [[nodiscard]] std::uint64_t eventsInHour(int hour) const;
+    [[nodiscard]] std::uint64_t peakPendingInHour(int hour) const;
+    [[nodiscard]] std::uint64_t retries(int trainNbr) const;
+    // The trains with the most retries, most first, at most count.
+    [[nodiscard]] std::vector<std::pair<int, std::uint64_t>> mostRetried(std::size_t count) const;
+
+private:
+    static constexpr std::size_t typeCount{9};
+    static constexpr int hours{24};
+
+    [[nodiscard]] static std::size_t indexOf(train::EventType type);
+    [[nodiscard]] static int hourOf(const EventNotice& notice) noexcept;
+
+    std::array<LatencyHistogram, typeCount> m_latency;
+    std::array<std::atomic<std::uint64_t>, hours> m_eventsPerHour{};
+    std::array<std::atomic<std::uint64_t>, hours> m_peakPending{};
+    std::atomic<std::uint64_t> m_scheduled{0};
+    std::atomic<std::uint64_t> m_processed{0};
+    // The simulated hour of the latest event, where the pending events
+    // are counted.
+    std::atomic<int> m_hour{0};
+    // The events of each type, by train number and then type.
+    std::vector<std::atomic<std::uint32_t>> m_trainEvents;
+};
+
+// Writes a report of the metrics.
+std::ostream& operator<<(std::ostream& os, const EventMetrics& metrics);
+
+}  // namespace pabo::app
+
+#endif
@@ -0,0 +1,45 @@
+/**
+    @file include/event_observer.h
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief The definition of the EventObserver class.
+
+    An observer is told about every event that the simulator
+    processes, just before and just after it is processed, without
+    changes to the events, and about every event that is scheduled.
+    See Simulator::addObserver.
+*/
+#ifndef INCLUDE_EVENT_OBSERVER_H
+#define INCLUDE_EVENT_OBSERVER_H
+
+#include "event_type.h"
+#include "time_point.h"
+
+namespace pabo::app {
+
+// What an observer is told about an event.
+struct EventNotice {
+    train::EventType type;
+    time::TimeOfDay time;
+    // 0 if the event concerns no train.
+    int trainNbr;
+};
+
+class EventObserver {
+public:
+    EventObserver() = default;
+    EventObserver(const EventObserver&) = default;
+    EventObserver(EventObserver&&) = default;
+    EventObserver& operator=(const EventObserver&) = default;
+    EventObserver& operator=(EventObserver&&) = default;
+    virtual ~EventObserver() = default;
+
+    virtual void eventScheduled(const EventNotice&) {}
+    virtual void beforeEvent(const EventNotice&) {}
+    virtual void afterEvent(const EventNotice&) {}
+};
+
+}  // namespace pabo::app
+
+#endif
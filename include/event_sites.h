@@ -0,0 +1,47 @@
+/**
+    @file include/event_sites.h
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief The definition of the EventSites class.
+
+    Maps events to the index of the station where they take place: the
+    origin of the train up until the departure and the destination
+    from the arrival onward. Used by the parallel execution modes to
+    partition the events by station.
+*/
+#ifndef INCLUDE_EVENT_SITES_H
+#define INCLUDE_EVENT_SITES_H
+
+#include "station_id.h"
+#include <cstddef>  // size_t
+#include <unordered_map>
+#include <utility>  // pair
+#include <vector>
+
+namespace pabo::train {
+class Event;
+class TrainDispatcher;
+}
+
+namespace pabo::app {
+
+class EventSites {
+public:
+    explicit EventSites(const train::TrainDispatcher& disp);
+
+    [[nodiscard]] std::size_t stationCount() const noexcept;
+    [[nodiscard]] train::StationId station(std::size_t idx) const;
+
+    // Throws logic_error if the event belongs to no station.
+    [[nodiscard]] std::size_t stationOf(const train::Event& event) const;
+
+private:
+    std::vector<train::StationId> m_stations;
+    // The index of the origin and the destination of each train.
+    std::unordered_map<int, std::pair<std::size_t, std::size_t>> m_sites;
+};
+
+}  // namespace pabo::app
+
+#endif
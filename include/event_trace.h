@@ -0,0 +1,106 @@
+/**
+    @file include/event_trace.h
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief The format of event traces and the TraceWriter class.
+
+    An event trace is a binary file with one fixed-width row for every
+    logged event, stored by column so that analysis can scan typed
+    arrays instead of parsing Trainsim.log. All values are stored in
+    the byte order of the machine that wrote the trace.
+
+    The file starts with a header:
+        char[8]   magic, "TRNTRACE"
+        uint32    format version
+        uint32    rows per chunk (a multiple of 8)
+        uint32    number of stations
+        for each station: uint16 length followed by the name
+        zero padding up to a multiple of 8 bytes
+
+    followed by chunks of the same size until the end of the file:
+        uint32    number of used rows
+        uint32    zero
+        int32     time in minutes        [rows per chunk]
+        int32     train number           [rows per chunk]
+        int32     departure delay        [rows per chunk]
+        int32     arrival delay          [rows per chunk]
+        float     speed in kph           [rows per chunk]
+        uint16    station id             [rows per chunk]
+        uint8     EventType              [rows per chunk]
+        uint8     Train::State           [rows per chunk]
+
+    The station id is the index of the station in the header, the
+    station where the event took place.
+*/
+#ifndef INCLUDE_EVENT_TRACE_H
+#define INCLUDE_EVENT_TRACE_H
+
+#include "station_id.h"
+#include <cstddef>  // size_t
+#include <cstdint>
+#include <iosfwd>  // ostream
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace pabo::train {
+
+struct TrainRecord;
+
+namespace trace {
+
+constexpr char magic[8]{'T', 'R', 'N', 'T', 'R', 'A', 'C', 'E'};
+constexpr std::uint32_t version{1};
+constexpr std::size_t defaultChunkRows{4096};
+
+// The size of a chunk, including its count.
+[[nodiscard]] constexpr std::size_t chunkSize(std::size_t rows) noexcept
+{
+    return 8 + rows * (5 * 4 + 2 + 1 + 1);
+}
+
+}  // namespace trace
+
+class TraceWriter {
+public:
+    // Throws invalid_argument if the rows are not a positive multiple
+    // of 8 or there are too many stations for the station ids.
+    TraceWriter(std::ostream& os, std::vector<std::string> stationNames,
+                std::size_t chunkRows = trace::defaultChunkRows);
+    ~TraceWriter();
+
+    TraceWriter(const TraceWriter&) = delete;
+    TraceWriter& operator=(const TraceWriter&) = delete;
+
+    // Throws out_of_range if the station of the record is unknown.
+    void write(const TrainRecord& tr);
+
+    // Writes the last chunk and flushes the stream.
+    void finish();
+
+private:
+    void writeHeader();
+    void writeChunk();
+
+    std::ostream& m_os;
+    std::vector<std::string> m_stationNames;
+    std::unordered_map<StationId, std::uint16_t> m_stationIds;
+    std::size_t m_chunkRows;
+
+    std::vector<std::int32_t> m_time;
+    std::vector<std::int32_t> m_trainNbr;
+    std::vector<std::int32_t> m_departureDelay;
+    std::vector<std::int32_t> m_arrivalDelay;
+    std::vector<float> m_speed;
+    std::vector<std::uint16_t> m_station;
+    std::vector<std::uint8_t> m_type;
+    std::vector<std::uint8_t> m_state;
+    // The chunk is assembled here and written with one call.
+    std::vector<char> m_chunk;
+    bool m_finished{false};
+};
+
+}  // namespace pabo::train
+
+#endif
@@ -0,0 +1,31 @@
+/**
+    @file include/event_type.h
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief The definition of the EventType enum.
+*/
+#ifndef INCLUDE_EVENT_TYPE_H
+#define INCLUDE_EVENT_TYPE_H
+
+#include <cstdint>  // uint8_t
+
+namespace pabo::train {
+
+// The type of an event, and of the event that logged a record. The
+// values are stored in event traces and must not change. Only the
+// first five log records.
+enum class EventType : std::uint8_t {
+    assembly = 1,
+    ready,
+    departure,
+    arrival,
+    disassembly,
+    start,
+    transfer,
+    transfer_arrival,
+};
+
+}  // namespace pabo::train
+
+#endif
@@ -10,6 +10,7 @@
 
 #include "event.h"
 #include "time_point.h"
+#include <optional>
 #include <string>
 
 namespace pabo::app {
@@ -25,13 +26,21 @@ class Train;
 
 class ArrivalEvent : public Event {
 public:
+    // A train that waited for a platform is woken with the time it
+    // started to wait, it already has the platform.
     ArrivalEvent(app::Simulator& sim, TrainDispatcher& disp,
-                 int trainNbr, time::TimeOfDay time);
+                 int trainNbr, time::TimeOfDay time,
+                 std::optional<time::TimeOfDay> waitingSince = std::nullopt);
 
 private:
     [[nodiscard]] bool isHighPriority_() const override { return true; }
     [[nodiscard]] std::string type_() const override { return "arrival"; }
+    [[nodiscard]] EventType eventType_() const override { return EventType::arrival; }
+    [[nodiscard]] int trainNbr_() const override { return m_trainNbr; }
+    [[nodiscard]] Site site_() const override { return Site::destination; }
     void processEvent_(TrainLog&, CarLog&) override;
+    // Puts the train in the platform queue if every platform is taken.
+    [[nodiscard]] bool waitForPlatform(TrainLog&);
     void updateStateOfTrain();
     void calculateDisassemblyTime();
     void logArrivingTrain(TrainLog& logger);
@@ -42,6 +51,7 @@ private:
     TrainDispatcher& m_disp;
     int m_trainNbr;
     const Train* m_currentTrain{nullptr};
+    std::optional<time::TimeOfDay> m_waitingSince;
     time::TimeOfDay m_disassemblyTime;
 };
 
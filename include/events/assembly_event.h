@@ -9,6 +9,7 @@
 #define INCLUDE_ASSEMBLY_EVENT_H
 
 #include "event.h"
+#include "station_id.h"
 #include "time_point.h"
 #include <string>
 
@@ -25,11 +26,22 @@ class Train;
 
 class AssemblyEvent : public Event {
 public:
+    // An incomplete train that waited for cars is woken with the
+    // number of attempts that it skipped, the departure is delayed
+    // as if each of them had failed.
     AssemblyEvent(app::Simulator& sim, TrainDispatcher& m_dis,
-                  int trainNbr, time::TimeOfDay time);
+                  int trainNbr, time::TimeOfDay time, int skippedAttempts = 0);
+
+    // Schedules the assembly of the trains that wait for the cars that
+    // an event has just added to the pool of a station.
+    static void wakeWaitingTrains(app::Simulator& sim, TrainDispatcher& disp,
+                                  StationId station, const Event& cause);
 
 private:
     [[nodiscard]] std::string type_() const override { return "assembly"; }
+    [[nodiscard]] EventType eventType_() const override { return EventType::assembly; }
+    [[nodiscard]] int trainNbr_() const override { return m_trainNbr; }
+    [[nodiscard]] Site site_() const override { return Site::origin; }
     [[nodiscard]] bool isHighPriority_() const override { return false; }
     void processEvent_(TrainLog&, CarLog&) override;
 
@@ -40,13 +52,15 @@ private:
 
     void processIncompleteTrain(TrainLog&);
     void calculateNextAttempt();
-    void delayDeparture();
-    void logIncompleteTrain(TrainLog&);
+    void delayDeparture(int attempts);
+    [[nodiscard]] bool waitForCars();
+    void logIncompleteTrain(TrainLog&, bool waiting);
     void scheduleNewAssemblyEvent();
 
     app::Simulator& m_sim;
     TrainDispatcher& m_disp;
     int m_trainNbr;
+    int m_skippedAttempts;
     const Train* m_currentTrain{nullptr};
     time::TimeOfDay m_timeOfNext;
 };
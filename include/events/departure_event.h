@@ -35,7 +35,12 @@ public:
 private:
     [[nodiscard]] bool isHighPriority_() const override { return false; }
     [[nodiscard]] std::string type_() const override { return "departure"; }
+    [[nodiscard]] EventType eventType_() const override { return EventType::departure; }
+    [[nodiscard]] int trainNbr_() const override { return m_trainNbr; }
+    [[nodiscard]] Site site_() const override { return Site::origin; }
     void processEvent_(TrainLog&, CarLog&) override;
+    // Delays the departure until the tracks of the route are free.
+    [[nodiscard]] bool waitForTrack(TrainLog& logger);
     void updateTrainState();
     void prepareLogMessage();
     void logDepartedTrain(TrainLog& logger);
@@ -34,6 +34,9 @@ public:
 private:
     [[nodiscard]] bool isHighPriority_() const override { return true; }
     [[nodiscard]] std::string type_() const override { return "disassembly"; }
+    [[nodiscard]] EventType eventType_() const override { return EventType::disassembly; }
+    [[nodiscard]] int trainNbr_() const override { return m_trainNbr; }
+    [[nodiscard]] Site site_() const override { return Site::destination; }
     void processEvent_(TrainLog&, CarLog&) override;
     void updateStateOfTrain();
     void logDisassembledTrain(TrainLog& logger);
@@ -8,6 +8,7 @@
 #ifndef INCLUDE_EVENT_H
 #define INCLUDE_EVENT_H
 
+#include "event_type.h"
 #include "time_point.h"
 #include "train_dispatcher.h"
 #include <memory>
@@ -20,13 +21,20 @@ using TrainView = TrainDispatcher::TrainView;
 class TrainLog;
 class CarLog;
 
+// Where an event takes place, relative to the connection of its train.
+enum class Site { none, origin, destination };
+
 class Event {
 public:
     Event(time::TimeOfDay t);
     void processEvent(TrainLog&, CarLog&);
     [[nodiscard]] time::TimeOfDay time() const;
     [[nodiscard]] std::string type() const;
+    [[nodiscard]] EventType eventType() const;
     [[nodiscard]] bool isHighPriority() const;
+    // The number of the train that the event concerns, 0 if none.
+    [[nodiscard]] int trainNbr() const;
+    [[nodiscard]] Site site() const;
 
     Event(const Event&) = delete;
     Event(Event&&) = delete;
@@ -39,12 +47,18 @@ public:
 private:
     virtual void processEvent_(TrainLog&, CarLog&) = 0;
     virtual std::string type_() const = 0;
+    virtual EventType eventType_() const = 0;
     virtual bool isHighPriority_() const = 0;
+    virtual int trainNbr_() const = 0;
+    virtual Site site_() const = 0;
 
 protected:
     time::TimeOfDay m_time{0};
 };
 
+// Orders events by time and then by train number. A train never has
+// more than one pending event, so the order is total and does not
+// depend on the order that the events were scheduled in.
 class EventComparison {
 public:
     bool operator()(const std::shared_ptr<Event>& lhs,
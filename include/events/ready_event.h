@@ -9,7 +9,9 @@
 #define INCLUDE_READY_EVENT_H
 
 #include "event.h"
+#include "station_id.h"
 #include "time_point.h"
+#include <optional>
 #include <string>
 
 namespace pabo::app {
@@ -25,13 +27,27 @@ class Train;
 
 class ReadyEvent : public Event {
 public:
+    // A train that waited for a platform is woken with the time it
+    // started to wait, it already has the platform.
     ReadyEvent(app::Simulator& sim, TrainDispatcher& disp,
-               int trainNbr, time::TimeOfDay time);
+               int trainNbr, time::TimeOfDay time,
+               std::optional<time::TimeOfDay> waitingSince = std::nullopt);
+
+    // Leaves a platform of a station for an event and schedules the
+    // event of the train that is given the platform, its ready or its
+    // arrival event.
+    static void leavePlatform(app::Simulator& sim, TrainDispatcher& disp,
+                              StationId station, const Event& cause);
 
 private:
     [[nodiscard]] bool isHighPriority_() const override { return false; }
     [[nodiscard]] std::string type_() const override { return "ready"; }
+    [[nodiscard]] EventType eventType_() const override { return EventType::ready; }
+    [[nodiscard]] int trainNbr_() const override { return m_trainNbr; }
+    [[nodiscard]] Site site_() const override { return Site::origin; }
     void processEvent_(TrainLog&, CarLog&) override;
+    // Puts the train in the platform queue if every platform is taken.
+    [[nodiscard]] bool waitForPlatform(TrainLog&);
     void updateStateOfTrain();
     void calculateTimeOfDeparture();
     void logReadyTrain(TrainLog&);
@@ -41,6 +57,7 @@ private:
     TrainDispatcher& m_disp;
     int m_trainNbr;
     const Train* m_currentTrain{nullptr};
+    std::optional<time::TimeOfDay> m_waitingSince;
     time::TimeOfDay m_timeOfDeparture;
 };
 
@@ -31,11 +31,16 @@ public:
 
 private:
     [[nodiscard]] std::string type_() const override { return "start"; }
+    [[nodiscard]] EventType eventType_() const override { return EventType::start; }
+    [[nodiscard]] int trainNbr_() const override { return 0; }
+    [[nodiscard]] Site site_() const override { return Site::none; }
     [[nodiscard]] bool isHighPriority_() const override { return false; }
 
     void processEvent_(TrainLog&, CarLog&) override;
     [[nodiscard]] time::TimeOfDay calculateAssemblyTime(int trainNbr) const;
     void scheduleAssemblyEvent(int trainNbr, time::TimeOfDay time);
+    // Plans and schedules the empty car moves, if enabled.
+    void scheduleTransferEvents();
 
     app::Simulator& m_sim;
     TrainDispatcher& m_disp;
@@ -0,0 +1,56 @@
+/**
+    @file include/transfer_arrival_event.h
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief The definition of the transfer arrival event.
+
+    Adds the cars of a transfer to the pool of their destination.
+*/
+#ifndef INCLUDE_TRANSFER_ARRIVAL_EVENT_H
+#define INCLUDE_TRANSFER_ARRIVAL_EVENT_H
+
+#include "event.h"
+#include "station_id.h"
+#include <string>
+#include <vector>
+
+namespace pabo::app {
+class Simulator;
+}
+
+namespace pabo::time {
+class TimeOfDay;
+}
+
+namespace pabo::train {
+
+class TrainDispatcher;
+class TrainLog;
+class CarLog;
+
+class TransferArrivalEvent : public Event {
+public:
+    TransferArrivalEvent(app::Simulator& sim, TrainDispatcher& disp,
+                         std::vector<int> carIds, StationId destination,
+                         time::TimeOfDay time);
+
+private:
+    // The cars must arrive even after the end time, or they would be
+    // lost in transit.
+    [[nodiscard]] bool isHighPriority_() const override { return true; }
+    [[nodiscard]] std::string type_() const override { return "transfer arrival"; }
+    [[nodiscard]] EventType eventType_() const override { return EventType::transfer_arrival; }
+    [[nodiscard]] int trainNbr_() const override { return 0; }
+    [[nodiscard]] Site site_() const override { return Site::none; }
+    void processEvent_(TrainLog&, CarLog&) override;
+
+    app::Simulator& m_sim;
+    TrainDispatcher& m_disp;
+    std::vector<int> m_carIds;
+    StationId m_destination;
+};
+
+}  // namespace pabo::train
+
+#endif
@@ -0,0 +1,47 @@
+/**
+    @file include/transfer_event.h
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief The definition of the transfer event.
+
+    Sends empty cars from one station to another, as planned by
+    planRepositioning.
+*/
+#ifndef INCLUDE_TRANSFER_EVENT_H
+#define INCLUDE_TRANSFER_EVENT_H
+
+#include "event.h"
+#include "repositioning.h"
+#include <string>
+
+namespace pabo::app {
+class Simulator;
+}
+
+namespace pabo::train {
+
+class TrainDispatcher;
+class TrainLog;
+class CarLog;
+
+class TransferEvent : public Event {
+public:
+    TransferEvent(app::Simulator& sim, TrainDispatcher& disp, Transfer transfer);
+
+private:
+    [[nodiscard]] std::string type_() const override { return "transfer"; }
+    [[nodiscard]] EventType eventType_() const override { return EventType::transfer; }
+    [[nodiscard]] int trainNbr_() const override { return 0; }
+    [[nodiscard]] Site site_() const override { return Site::none; }
+    [[nodiscard]] bool isHighPriority_() const override { return false; }
+    void processEvent_(TrainLog&, CarLog&) override;
+
+    app::Simulator& m_sim;
+    TrainDispatcher& m_disp;
+    Transfer m_transfer;
+};
+
+}  // namespace pabo::train
+
+#endif
@@ -0,0 +1,57 @@
+/**
+    @file include/latency_histogram.h
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief The definition of the LatencyHistogram class.
+
+    A histogram of durations in nanoseconds with log-linear buckets,
+    as in an HDR histogram: every power of two is split into 16
+    buckets, so a value is known to within 1/16 of itself and the
+    range from one nanosecond to centuries fits in a thousand buckets.
+    The buckets are atomic counters, so any number of threads can
+    record at once without a lock.
+*/
+#ifndef INCLUDE_LATENCY_HISTOGRAM_H
+#define INCLUDE_LATENCY_HISTOGRAM_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>  // size_t
+#include <cstdint>  // uint64_t
+
+namespace pabo {
+
+class LatencyHistogram {
+public:
+    LatencyHistogram() = default;
+
+    void record(std::uint64_t nanoseconds) noexcept;
+
+    [[nodiscard]] std::uint64_t count() const noexcept;
+    [[nodiscard]] std::uint64_t total() const noexcept;
+    [[nodiscard]] std::uint64_t max() const noexcept;
+    // 0 if nothing was recorded.
+    [[nodiscard]] double mean() const noexcept;
+    // The highest value of the bucket where the quantile is reached,
+    // 0 if nothing was recorded. Throws out_of_range if the quantile
+    // is not in [0, 1].
+    [[nodiscard]] std::uint64_t valueAt(double quantile) const;
+
+private:
+    static constexpr int subBucketBits{4};
+    static constexpr std::size_t subBuckets{std::size_t{1} << subBucketBits};
+    static constexpr std::size_t bucketCount{(64 - subBucketBits + 1) * subBuckets};
+
+    [[nodiscard]] static std::size_t bucketOf(std::uint64_t value) noexcept;
+    [[nodiscard]] static std::uint64_t highestIn(std::size_t bucket) noexcept;
+
+    std::array<std::atomic<std::uint64_t>, bucketCount> m_buckets{};
+    std::atomic<std::uint64_t> m_count{0};
+    std::atomic<std::uint64_t> m_total{0};
+    std::atomic<std::uint64_t> m_max{0};
+};
+
+}  // namespace pabo
+
+#endif
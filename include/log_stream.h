@@ -0,0 +1,58 @@
+/**
+    @file include/log_stream.h
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief The definition of the LogStream class.
+
+    Writes train records to a stream while the simulation runs. The
+    records are handed to a writer thread through a bounded ring, so
+    the memory used does not grow with the length of the run. When
+    the ring is full the simulation waits for the writer.
+*/
+#ifndef INCLUDE_LOG_STREAM_H
+#define INCLUDE_LOG_STREAM_H
+
+#include "printer.h"
+#include "spsc_ring.h"
+#include "train_log.h"
+#include <atomic>
+#include <cstddef>  // size_t
+#include <exception>  // exception_ptr
+#include <iosfwd>  // ostream
+#include <thread>
+
+namespace pabo::train {
+
+class LogStream {
+public:
+    static constexpr std::size_t defaultCapacity{4096};
+
+    // The records are formatted like the printer formats them.
+    LogStream(std::ostream& os, const Printer& printer,
+              std::size_t capacity = defaultCapacity);
+    ~LogStream();
+
+    LogStream(const LogStream&) = delete;
+    LogStream& operator=(const LogStream&) = delete;
+
+    // Called by the thread that logs the records.
+    void write(TrainRecord tr);
+
+    // Writes the remaining records and stops the writer. Rethrows an
+    // exception thrown by the writer.
+    void finish();
+
+private:
+    void run();
+
+    Printer m_printer;
+    app::SpscRing<TrainRecord> m_ring;
+    std::atomic<bool> m_done{false};
+    std::exception_ptr m_error;
+    std::thread m_writer;
+};
+
+}  // namespace pabo::train
+
+#endif
@@ -0,0 +1,70 @@
+/**
+    @file include/min_cost_flow.h
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief The definition of the MinCostFlow class.
+
+    A network of directed edges with capacities and costs in which the
+    largest possible flow is sent from a source to a sink at the lowest
+    total cost. Solved with successive shortest paths, using Dijkstra
+    on costs reduced by node potentials.
+*/
+#ifndef INCLUDE_MIN_COST_FLOW_H
+#define INCLUDE_MIN_COST_FLOW_H
+
+#include <cstddef>  // size_t
+#include <cstdint>  // int64_t
+#include <vector>
+
+namespace pabo {
+
+class MinCostFlow {
+public:
+    using Node = std::size_t;
+    using Edge = std::size_t;
+    using Amount = std::int64_t;
+
+    struct Result {
+        Amount flow{0};
+        Amount cost{0};
+    };
+
+    explicit MinCostFlow(std::size_t nodes = 0);
+
+    // Adds a node and returns it.
+    Node addNode();
+    [[nodiscard]] std::size_t nodeCount() const noexcept;
+    // Adds an edge and returns it. Throws out_of_range if a node does
+    // not exist and invalid_argument if the capacity or the cost is
+    // negative.
+    Edge addEdge(Node from, Node to, Amount capacity, Amount cost);
+
+    // Sends the maximum flow from the source to the sink at the lowest
+    // cost. The flow of the edges is kept until the next solve.
+    Result solve(Node source, Node sink);
+    // The flow on an edge after solve.
+    [[nodiscard]] Amount flow(Edge e) const;
+
+private:
+    struct Arc {
+        Node to;
+        Amount capacity;
+        Amount cost;
+    };
+
+    [[nodiscard]] bool findShortestPath(Node source, Node sink);
+
+    // Each edge is stored as a pair of arcs, the forward arc at an even
+    // index and its residual at the next. The capacity of a residual
+    // arc is the flow on the edge.
+    std::vector<Arc> m_arcs;
+    std::vector<std::vector<std::size_t>> m_out;
+    std::vector<Amount> m_potential;
+    std::vector<Amount> m_dist;
+    std::vector<std::size_t> m_prevArc;
+};
+
+}  // namespace pabo
+
+#endif
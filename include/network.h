@@ -0,0 +1,44 @@
+/**
+    @file include/network.h
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief The definition of the Network struct.
+
+    The network is the static data of a simulation: the timetable and
+    the distances between the stations. It is never modified once it
+    is loaded, so one instance can be shared by any number of
+    dispatchers, also across threads. The routes are computed from the
+    map when it is loaded, see route_table.h, and the speed profile of
+    the route of every connection once the routes are known. The
+    connections are indexed by station, see timetable.h.
+*/
+#ifndef INCLUDE_NETWORK_H
+#define INCLUDE_NETWORK_H
+
+#include "path.h"
+#include "route_table.h"
+#include "speed_profile.h"
+#include "timetable.h"
+#include "train_connection.h"
+#include <vector>
+
+namespace pabo::train {
+
+struct Network {
+    Network() = default;
+    // Throws out_of_range if a connection has no route.
+    Network(std::vector<TrainConnection> connections, std::vector<Path> map,
+            RouteTable routes);
+
+    std::vector<TrainConnection> connections;
+    std::vector<Path> map;
+    RouteTable routes;
+    // The speed profile of each connection, in the same order.
+    std::vector<SpeedProfile> profiles;
+    Timetable timetable;
+};
+
+}  // namespace pabo::train
+
+#endif
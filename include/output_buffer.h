@@ -0,0 +1,56 @@
+/**
+    @file include/output_buffer.h
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief The definition of the OutputBuffer class.
+
+    Formats text into a char buffer and writes it to a stream in large
+    blocks. Numbers are formatted with to_chars, so the formatting
+    state of the stream is neither used nor changed.
+*/
+#ifndef INCLUDE_OUTPUT_BUFFER_H
+#define INCLUDE_OUTPUT_BUFFER_H
+
+#include "capacity.h"
+#include "time_point.h"
+#include <cstddef>  // size_t
+#include <iosfwd>  // ostream
+#include <string_view>
+#include <vector>
+
+namespace pabo::train {
+
+class OutputBuffer {
+public:
+    static constexpr std::size_t blockSize{64 * 1024};
+
+    // The storage is reused between buffers to avoid allocations.
+    OutputBuffer(std::ostream& os, std::vector<char>& storage);
+    ~OutputBuffer();
+
+    OutputBuffer(const OutputBuffer&) = delete;
+    OutputBuffer& operator=(const OutputBuffer&) = delete;
+
+    OutputBuffer& operator<<(std::string_view str);
+    OutputBuffer& operator<<(char c);
+    OutputBuffer& operator<<(int value);
+    // Formatted as hh:mm.
+    OutputBuffer& operator<<(const time::TimeOfDay& tod);
+    // The value is rounded to an integer.
+    OutputBuffer& operator<<(const Capacity<double>& cap);
+
+    // Writes the buffered text to the stream.
+    void flush();
+
+private:
+    [[nodiscard]] char* reserve(std::size_t n);
+
+    std::ostream& m_os;
+    std::vector<char>& m_buffer;
+    std::size_t m_size{0};
+};
+
+}  // namespace pabo::train
+
+#endif
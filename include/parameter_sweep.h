@@ -0,0 +1,82 @@
+/**
+    @file include/parameter_sweep.h
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief The definition of the ParameterSweep class.
+
+    A parameter sweep runs the complete simulation once for every
+    configuration in a grid and collects a summary of each run.
+*/
+#ifndef INCLUDE_PARAMETER_SWEEP_H
+#define INCLUDE_PARAMETER_SWEEP_H
+
+#include "network.h"
+#include "scenario.h"
+#include "sim_config.h"
+#include "station.h"
+#include "time_point.h"
+#include <iosfwd>
+#include <memory>  // shared_ptr
+#include <string>
+#include <vector>
+
+namespace pabo::app {
+
+class ThreadPool;
+
+// The values to try for each duration of a SimConfig, in minutes.
+// An empty list keeps the default value of the duration.
+struct SweepGrid {
+    // Sets the values of a parameter by its name, one of assembly,
+    // ready, retry, departure or disassembly.
+    // Throws invalid_argument if the name is unknown.
+    void setValues(const std::string& name, std::vector<int> minutes);
+
+    // Returns one configuration for every combination of values.
+    [[nodiscard]] std::vector<SimConfig> configurations() const;
+
+    std::vector<int> departureToAssembly;
+    std::vector<int> assembledToReady;
+    std::vector<int> assemblyAttempts;
+    std::vector<int> readyToDeparture;
+    std::vector<int> arrivalToDisassembly;
+};
+
+struct SweepResult {
+    SimConfig config;
+    time::TimeOfDay totalDepartureDelay;
+    time::TimeOfDay totalArrivalDelay;
+    int completedTrains{0};
+};
+
+class ParameterSweep {
+public:
+    ParameterSweep(std::shared_ptr<const train::Network>,
+                   std::vector<train::Station> fleet);
+
+    // The start and end time used by every run.
+    void setTimeSpan(time::TimeOfDay start, time::TimeOfDay end);
+
+    // Runs the simulation once for each configuration using the
+    // threads of the pool. The results are in the same order as the
+    // configurations.
+    [[nodiscard]] std::vector<SweepResult> run(const std::vector<SimConfig>&,
+                                               ThreadPool& pool) const;
+
+    // Runs the simulation to completion using a configuration.
+    [[nodiscard]] SweepResult runOne(const SimConfig&) const;
+
+private:
+    ScenarioRunner m_runner;
+    time::TimeOfDay m_start{"00:00"};
+    time::TimeOfDay m_end{"23:59"};
+};
+
+// Writes the results as comma separated values with all durations
+// in minutes.
+void writeCsv(std::ostream& os, const std::vector<SweepResult>& results);
+
+}  // namespace pabo::app
+
+#endif
@@ -6,30 +6,43 @@
     @brief Definition of the Path class.
 
     A path is a connection between two points. The points each have
-    a name and a distance between them.
+    a name and a distance between them. A path may also have a speed
+    limit that no train runs faster than on it, it is written after
+    the distance on the same line of the map.
 */
 #ifndef INCLUDE_MAP_H
 #define INCLUDE_MAP_H
 
 #include "capacity.h"
+#include "station_id.h"
 #include <iosfwd>
-#include <string>
+#include <limits>  // numeric_limits
+#include <string_view>
 
 namespace pabo::train {
 
 class Path {
 public:
+    // The speed limit of a path without one.
+    static constexpr auto noSpeedLimit = std::numeric_limits<double>::infinity();
+
     Path() = default;
-    Path(std::string a, std::string b, double distance = 0.0);
+    Path(std::string_view a, std::string_view b, double distance = 0.0,
+         double speedLimit = noSpeedLimit);
+    Path(StationId a, StationId b, double distance = 0.0,
+         double speedLimit = noSpeedLimit);
 
-    [[nodiscard]] std::string pointA() const;
-    [[nodiscard]] std::string pointB() const;
+    [[nodiscard]] StationId pointA() const;
+    [[nodiscard]] StationId pointB() const;
     [[nodiscard]] Capacity<double> distance() const;
+    [[nodiscard]] Capacity<double> speedLimit() const;
+    [[nodiscard]] bool hasSpeedLimit() const;
 
 private:
-    std::string m_pointA;
-    std::string m_pointB;
+    StationId m_pointA{noStation};
+    StationId m_pointB{noStation};
     Capacity<double> m_distance;
+    Capacity<double> m_speedLimit{noSpeedLimit, "kph"};
 };
 
 // Returns true of lhs and rhs contains the same points
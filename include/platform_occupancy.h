@@ -0,0 +1,97 @@
+/**
+    @file include/platform_occupancy.h
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief The definition of the PlatformOccupancy class.
+
+    The platforms of one station. A train takes a platform from the
+    time it is ready until it departs, and from the time it arrives
+    until it is disassembled. A train that finds every platform taken
+    waits in a queue and is given the platform of the first train that
+    leaves, in the order that the trains came.
+
+    The number of trains at the platforms is kept as a timeline of
+    changes, each with the platform minutes before it. The events of a
+    station nearly always come in order, so a change is added to the
+    end and the number of trains at a time, or the platform minutes in
+    an interval, is a binary search. A change before the last one, an
+    assembly that wrapped around midnight, is inserted and the changes
+    after it are updated.
+*/
+#ifndef INCLUDE_PLATFORM_OCCUPANCY_H
+#define INCLUDE_PLATFORM_OCCUPANCY_H
+
+#include <deque>
+#include <functional>  // function
+#include <optional>
+#include <vector>
+
+namespace pabo::train {
+
+class PlatformOccupancy {
+public:
+    // A train that waits for a platform, since a time.
+    struct Waiter {
+        int trainNbr;
+        int since;
+    };
+
+    // A station without a platform count has no limit. Throws
+    // invalid_argument if the number of platforms is negative.
+    explicit PlatformOccupancy(int platforms = 0);
+
+    // The number of platforms, 0 if they are not limited.
+    [[nodiscard]] int platforms() const noexcept;
+    [[nodiscard]] bool isLimited() const noexcept;
+    // The number of trains at the platforms now.
+    [[nodiscard]] int occupied() const noexcept;
+    [[nodiscard]] int waitingCount() const noexcept;
+    // The highest number of trains at the platforms at once.
+    [[nodiscard]] int peak() const noexcept;
+
+    // The number of trains at the platforms at a time.
+    [[nodiscard]] int occupiedAt(int time) const;
+    // The sum of the minutes that each train spent at a platform in
+    // [begin, end).
+    [[nodiscard]] long busyMinutes(int begin, int end) const;
+    // The average number of trains at the platforms in [begin, end).
+    [[nodiscard]] double averageOccupied(int begin, int end) const;
+    // The average number of trains at the platforms from the first to
+    // the last change, 0 if there is none.
+    [[nodiscard]] double averageOccupied() const;
+
+    // Takes a platform for a train. Returns false, and puts the train
+    // last in the queue, if every platform is taken.
+    [[nodiscard]] bool take(int time, int trainNbr);
+    // Leaves a platform. The platform is given to the first train in
+    // the queue, which is returned, if it is accepted by the
+    // predicate. Throws logic_error if no platform is taken.
+    [[nodiscard]] std::optional<Waiter> leave(int time,
+                                              const std::function<bool(const Waiter&)>& accept);
+    // Removes and returns every waiting train.
+    [[nodiscard]] std::vector<Waiter> takeWaiters();
+
+private:
+    struct Change {
+        int time;
+        int occupied;
+        // The platform minutes before the change.
+        long busyBefore;
+    };
+
+    // Adds a change of the number of trains at a time.
+    void record(int time, int change);
+    // The platform minutes before a time.
+    [[nodiscard]] long busyBefore(int time) const;
+
+    int m_platforms;
+    int m_occupied{0};
+    int m_peak{0};
+    std::deque<Waiter> m_waiting;
+    std::vector<Change> m_timeline;
+};
+
+}  // namespace pabo::train
+
+#endif
@@ -8,6 +8,8 @@
 #ifndef INCLUDE_PRINTER_H
 #define INCLUDE_PRINTER_H
 
+#include "departure_board.h"
+#include "timetable.h"
 #include "train.h"
 #include "train_log.h"
 #include "vehicle.h"
@@ -18,6 +20,7 @@
 namespace pabo::train {
 
 struct CarRecord;
+class OutputBuffer;
 class Station;
 class TrainDispatcher;
 
@@ -30,7 +33,7 @@ using namespace std::string_literals;
 
 class Printer {
 public:
-    using Iterator = std::vector<TrainRecord>::iterator;
+    using Iterator = TrainLog::ConstIterator;
     using Car = Vehicle;
 
     Printer(TrainDispatcher& disp);
@@ -61,6 +64,12 @@ public:
 
     // Print the state of a station
     void print(const Station& stn);
+    // Print the departures from, or the arrivals at, a station with
+    // their scheduled and estimated times, one train per line.
+    void printDepartures(Timetable::Entries departures);
+    void printArrivals(Timetable::Entries arrivals);
+    // Print the rows of a departure board.
+    void print(const DepartureBoard& board);
 
     // Misc print operations on a car.
     void print(const Car& car);
@@ -71,9 +80,15 @@ public:
     void print(const CarRecord& rec);
 
 private:
+    // Records and trains are formatted into a buffer that is written
+    // to the stream in large blocks.
+    void format(OutputBuffer& out, const TrainRecord& tr) const;
+    void format(OutputBuffer& out, const TrainSummary& train) const;
+
     LogLevel m_logLvl{LogLevel::high};
     TrainDispatcher& m_disp;
     std::ostream* os{&std::cout};
+    std::vector<char> m_buffer;
 };
 
 }  // namespace pabo::train
@@ -0,0 +1,52 @@
+/**
+    @file include/repositioning.h
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief The planning of empty car moves between stations.
+
+    Cars only move between stations attached to a train. A station that
+    sends away more cars of a type than it gets back runs short, while
+    the cars pile up at another. The plan moves empty cars from the
+    stations with a surplus to the ones that run short, in time for
+    the trains that need them.
+
+    The plan is a minimum cost flow over a time-expanded network, one
+    network per car type. A node is a station at a time when a train
+    takes or returns cars of the type. The cars wait at a station
+    along the arcs between its nodes and are moved along arcs between
+    the stations, which cost the distance. The flow gets as many cars
+    as possible to the trains, over the shortest total distance.
+*/
+#ifndef INCLUDE_REPOSITIONING_H
+#define INCLUDE_REPOSITIONING_H
+
+#include "sim_config.h"
+#include "station_id.h"
+#include "time_point.h"
+#include "vehicle.h"
+#include <vector>
+
+namespace pabo::train {
+
+class TrainDispatcher;
+
+// An empty move of cars of one type from one station to another.
+struct Transfer {
+    Vehicle::Type type;
+    int count;
+    StationId from;
+    StationId to;
+    time::TimeOfDay departure;
+    time::TimeOfDay arrival;
+};
+
+// Plans the moves from the timetable and the car pools of the
+// dispatcher, for the cars that the trains still miss. The cars are
+// moved as late as they can be. The moves are in order of departure.
+[[nodiscard]] std::vector<Transfer> planRepositioning(const TrainDispatcher&,
+                                                      const SimConfig&);
+
+}  // namespace pabo::train
+
+#endif
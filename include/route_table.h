@@ -0,0 +1,101 @@
+/**
+    @file include/route_table.h
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief The definition of the RouteTable class.
+
+    The map is a graph with the stations as nodes and the paths as
+    undirected, weighted edges. The table holds the shortest distance
+    and the first station on the shortest route between every pair of
+    stations, so a train can run between stations that have no direct
+    path and every lookup takes constant time. The speed limits along a
+    route are given by its speed profile, see speed_profile.h.
+
+    The table is computed once when the map is loaded. Small networks
+    use Floyd-Warshall, large ones a Dijkstra from every station, which
+    is faster on a sparse map. Both spread the work over a thread pool
+    when they are given one.
+*/
+#ifndef INCLUDE_ROUTE_TABLE_H
+#define INCLUDE_ROUTE_TABLE_H
+
+#include "capacity.h"
+#include "path.h"
+#include "speed_profile.h"
+#include "station_id.h"
+#include <cstddef>  // size_t
+#include <vector>
+
+namespace pabo::app {
+class ThreadPool;
+}
+
+namespace pabo::train {
+
+class RouteTable {
+public:
+    using Distance = Capacity<double>;
+
+    // A path of a route, by its position in the map.
+    struct Leg {
+        std::size_t path;
+        double distance;
+        double speedLimit;
+    };
+
+    RouteTable() = default;
+    // Throws invalid_argument if a path has a negative distance.
+    explicit RouteTable(const std::vector<Path>& map);
+    RouteTable(const std::vector<Path>& map, app::ThreadPool& pool);
+
+    // Whether there is a route between two stations. A station on the
+    // map has a route of length zero to itself.
+    [[nodiscard]] bool hasRoute(StationId from, StationId to) const noexcept;
+    // The length of the shortest route. Throws out_of_range if there
+    // is no route.
+    [[nodiscard]] Distance distance(StationId from, StationId to) const;
+    // The station after from on the shortest route. Throws
+    // out_of_range if there is no route.
+    [[nodiscard]] StationId nextHop(StationId from, StationId to) const;
+    // The stations of the shortest route, from and to included.
+    // Throws out_of_range if there is no route.
+    [[nodiscard]] std::vector<StationId> route(StationId from, StationId to) const;
+    // The paths of the shortest route in order. Throws out_of_range if
+    // there is no route.
+    [[nodiscard]] std::vector<Leg> legs(StationId from, StationId to) const;
+    // The speed limits of the paths of the shortest route. Throws
+    // out_of_range if there is no route.
+    [[nodiscard]] SpeedProfile profile(StationId from, StationId to) const;
+
+    [[nodiscard]] std::size_t stationCount() const noexcept;
+
+private:
+    RouteTable(const std::vector<Path>& map, app::ThreadPool* pool);
+
+    void floydWarshall(app::ThreadPool* pool);
+    void dijkstra(app::ThreadPool* pool);
+
+    [[nodiscard]] std::size_t indexOf(StationId id) const noexcept;
+    // The position of a pair in the tables, throws out_of_range if
+    // there is no route.
+    [[nodiscard]] std::size_t cellOf(StationId from, StationId to) const;
+
+    struct Edge {
+        std::size_t to;
+        Leg leg;
+    };
+
+    std::vector<StationId> m_stations;
+    // Positions in m_stations, indexed by station id.
+    std::vector<std::size_t> m_index;
+    // The paths from each station of m_stations.
+    std::vector<std::vector<Edge>> m_edges;
+    // Row major, one row per station of m_stations.
+    std::vector<double> m_distance;
+    std::vector<StationId> m_next;
+};
+
+}  // namespace pabo::train
+
+#endif
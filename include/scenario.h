@@ -0,0 +1,79 @@
+/**
+    @file include/scenario.h
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief The definition of the ScenarioRunner class.
+
+    A scenario is a variant of a simulation run over a shared network.
+    Runs only copy the state that they modify: the trains and the car
+    pools of the stations. The connections, the distances and the
+    vehicles themselves are shared by every run.
+*/
+#ifndef INCLUDE_SCENARIO_H
+#define INCLUDE_SCENARIO_H
+
+#include "network.h"
+#include "sim_config.h"
+#include "station.h"
+#include "time_point.h"
+#include <iosfwd>
+#include <memory>  // shared_ptr
+#include <string>
+#include <vector>
+
+namespace pabo::app {
+
+class ThreadPool;
+
+using train::SimConfig;
+
+struct Scenario {
+    std::string name;
+    time::TimeOfDay start{"00:00"};
+    time::TimeOfDay end{"23:59"};
+    SimConfig config;
+    // Ids of vehicles that are taken out of service before the start.
+    std::vector<int> removedVehicles;
+    // The car pools of the stations. An empty fleet uses the fleet
+    // of the runner.
+    std::vector<train::Station> fleet;
+    // The platforms of every station, 0 keeps those of the fleet.
+    int platforms{0};
+};
+
+struct ScenarioResult {
+    std::string name;
+    time::TimeOfDay totalDepartureDelay;
+    time::TimeOfDay totalArrivalDelay;
+    int completedTrains{0};
+};
+
+class ScenarioRunner {
+public:
+    ScenarioRunner(std::shared_ptr<const train::Network>,
+                   std::vector<train::Station> fleet);
+
+    // Runs every scenario using the threads of the pool. The results
+    // are in the same order as the scenarios.
+    [[nodiscard]] std::vector<ScenarioResult> run(const std::vector<Scenario>&,
+                                                  ThreadPool& pool) const;
+
+    // Runs a single scenario to completion.
+    // Throws out_of_range if a removed vehicle is not in the fleet.
+    [[nodiscard]] ScenarioResult runOne(const Scenario&) const;
+
+private:
+    [[nodiscard]] std::vector<train::Station> fleetOf(const Scenario&) const;
+
+    std::shared_ptr<const train::Network> m_network;
+    std::vector<train::Station> m_fleet;
+};
+
+// Writes the results as comma separated values with all durations
+// in minutes.
+void writeCsv(std::ostream& os, const std::vector<ScenarioResult>& results);
+
+}  // namespace pabo::app
+
+#endif
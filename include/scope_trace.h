@@ -0,0 +1,65 @@
+/**
+    @file include/scope_trace.h
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief The definition of the ScopeTrace class.
+
+    Scoped tracing for finding where the time goes: PABO_TRACE_SCOPE
+    records the name, start and duration of the enclosing scope. Each
+    thread records into its own ring buffer, which keeps the latest
+    records, so recording takes no lock. writeScopeTraces exports the
+    records of every thread in the Chrome trace event format, which
+    chrome://tracing and Perfetto show as a timeline.
+
+    Tracing is only compiled in when PABO_TRACING is defined, with the
+    CMake option of the same name. Otherwise the macro expands to
+    nothing and the class and functions do not exist.
+*/
+#ifndef INCLUDE_SCOPE_TRACE_H
+#define INCLUDE_SCOPE_TRACE_H
+
+#ifdef PABO_TRACING
+
+#include <cstdint>  // int64_t
+#include <iosfwd>  // ostream
+
+namespace pabo {
+
+class ScopeTrace {
+public:
+    // The name must be a string literal, it is kept until it is
+    // exported.
+    explicit ScopeTrace(const char* name) noexcept;
+    ~ScopeTrace();
+
+    ScopeTrace(const ScopeTrace&) = delete;
+    ScopeTrace(ScopeTrace&&) = delete;
+    ScopeTrace& operator=(const ScopeTrace&) = delete;
+    ScopeTrace& operator=(ScopeTrace&&) = delete;
+
+private:
+    const char* m_name;
+    std::int64_t m_start;
+};
+
+// Writes the records of every thread as a Chrome trace JSON object.
+// Must not be called while another thread records.
+void writeScopeTraces(std::ostream& os);
+// Forgets every record. Must not be called while another thread
+// records.
+void clearScopeTraces() noexcept;
+
+}  // namespace pabo
+
+#define PABO_TRACE_CONCAT_(a, b) a##b
+#define PABO_TRACE_VARIABLE_(line) PABO_TRACE_CONCAT_(pabo_trace_scope_, line)
+#define PABO_TRACE_SCOPE(name) const ::pabo::ScopeTrace PABO_TRACE_VARIABLE_(__LINE__){name}
+
+#else
+
+#define PABO_TRACE_SCOPE(name) static_cast<void>(0)
+
+#endif
+
+#endif
@@ -0,0 +1,49 @@
+/**
+    @file include/sim_config.h
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief The runtime configuration of the simulator.
+
+    Holds the durations of the processes that the events model, the
+    policy that allocates cars to trains, whether empty cars are
+    repositioned and how many tracks a path has. The default values are the ones given by the project
+    specification.
+*/
+#ifndef INCLUDE_SIM_CONFIG_H
+#define INCLUDE_SIM_CONFIG_H
+
+#include "allocation_policy.h"
+#include "time_point.h"
+#include <memory>  // shared_ptr
+
+namespace pabo::train {
+
+struct SimConfig {
+    using Duration = time::TimeOfDay;
+
+    // Throws invalid_argument if the configuration would keep the
+    // simulation from making progress.
+    void validate() const;
+
+    Duration timeBetweenDepartureAndAssembly{"00:30"};
+    Duration timeBetweenAssembledAndReady{"00:10"};
+    Duration timeBetweenAssemblyAttempts{"00:10"};
+    Duration timeBetweenReadyAndDeparture{"00:10"};
+    Duration timeBetweenArrivalAndDisassembly{"00:20"};
+
+    std::shared_ptr<const AllocationPolicy> allocation{makeAllocationPolicy("lowest-id")};
+
+    // Moves empty cars to the stations that will run short of them,
+    // see repositioning.h. The speed of the moves is in kph.
+    bool repositioning{false};
+    double repositioningSpeed{90.0};
+
+    // The number of trains that can run on a path at the same time, a
+    // departure waits for a free track. 0 for no limit.
+    int tracksPerPath{0};
+};
+
+}  // namespace pabo::train
+
+#endif
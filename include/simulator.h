@@ -9,7 +9,11 @@
 #define INCLUDE_SIMULATOR_H
 
 #include "event.h"
+#include "event_hooks.h"
+#include "sim_config.h"
 #include "time_point.h"
+#include <atomic>
+#include <iosfwd>  // ostream
 #include <memory>
 #include <queue>
 #include <string>
@@ -23,16 +27,32 @@ class TrainDispatcher;
 
 namespace pabo::app {
 
+class EventBatch;
+class StationPartitions;
+class ThreadPool;
+class TimeWarp;
+
 using std::vector;
 using std::shared_ptr;
 using train::EventComparison;
 using std::priority_queue;
 using pabo::train::TrainLog;
 using pabo::train::CarLog;
+using pabo::train::SimConfig;
 
 class Simulator {
 public:
+    // How runToCompletion processes the events. The parallel modes
+    // run the stations in parallel: the batched mode the events that
+    // share a timestamp with EventBatch, the conservative mode with
+    // StationPartitions and the optimistic mode with TimeWarp. The
+    // optimistic mode runs conservatively with an allocation policy
+    // that does not support rollback. Every mode runs sequentially if
+    // empty cars are repositioned.
+    enum class Execution { sequential, batched, conservative, optimistic };
+
     Simulator(train::TrainDispatcher&, TrainLog&, CarLog&);
+    ~Simulator();
     using Duration = time::TimeOfDay;
 
     // Queries
@@ -44,6 +64,11 @@ public:
     [[nodiscard]] time::TimeOfDay currentTime() const;
     [[nodiscard]] bool isFinished() const;
     [[nodiscard]] bool timeIsUp() const;
+    [[nodiscard]] const SimConfig& config() const noexcept;
+    [[nodiscard]] Execution execution() const noexcept;
+    // How far the optimistic mode runs ahead of the earliest pending
+    // event.
+    [[nodiscard]] Duration optimisticWindow() const noexcept;
 
     // Reset the state of the simulator
     void reset();
@@ -53,11 +78,29 @@ public:
     void setEndTime(std::string);
     void setInterval(int minutes);
 
+    // Set the durations used by the events.
+    // Throws invalid_argument if the configuration is not valid.
+    void setConfig(SimConfig config);
+    void setExecution(Execution e) noexcept;
+    void setOptimisticWindow(Duration window);
+
+    // Tells an observer about every event from now on, see
+    // event_observer.h. The observer must outlive the simulator or be
+    // removed. In the parallel modes the observers are called from
+    // the threads of the pool, at once for events at different
+    // stations, and in the optimistic mode also for the events that
+    // are rolled back and processed again.
+    void addObserver(EventObserver& observer);
+    void removeObserver(const EventObserver& observer) noexcept;
+
     // Event handling.
     void scheduleEvent(std::shared_ptr<train::Event>);
     void runNextEvent();
     void runNextInterval();
     void runToCompletion();
+    // Uses the pool when the execution mode is parallel. The resulting
+    // logs are the same for every mode.
+    void runToCompletion(ThreadPool& pool);
 
 private:
     using EventPtr = shared_ptr<train::Event>;
@@ -66,19 +109,40 @@ private:
     [[nodiscard]] auto nextEvent() const;
     void syncClockWithEvent(const train::Event& event);
     void runTo(const Duration& end);
+    void processNextEvent();
+    // Delays the trains that still wait for cars when no event is left
+    // to wake them, by the attempts they would have made before the
+    // end time, and the trains that still wait for a platform until
+    // the end time.
+    void settleWaitingTrains();
+    void stopWhenIdle();
+    void runStartEvents();
+    void runBatched(ThreadPool& pool);
+    void runConservatively(ThreadPool& pool);
+    void runOptimistically(ThreadPool& pool);
 
     time::TimeOfDay m_start{"00:00"};
     time::TimeOfDay m_end{"23:59"};
     time::TimeOfDay m_clock{"00:00"};
     Duration m_interval{"00:10"};
+    SimConfig m_config;
+    Execution m_execution{Execution::sequential};
+    Duration m_optimisticWindow{"02:00"};
 
     train::TrainDispatcher& m_dispatch;
     TrainLog& m_log;
     CarLog& m_carLog;
-    int m_highPriorityEvents{0};
+    EventHooks m_hooks;
+    std::atomic<int> m_highPriorityEvents{0};
     priority_queue<EventPtr, vector<EventPtr>, EventComparison> m_queue;
+    // Set while the stations are run in parallel.
+    std::unique_ptr<EventBatch> m_batch;
+    std::unique_ptr<StationPartitions> m_partitions;
+    std::unique_ptr<TimeWarp> m_timeWarp;
 };
 
+std::ostream& operator<<(std::ostream& os, Simulator::Execution e);
+
 
 }  // namespace pabo::app
 
@@ -0,0 +1,181 @@
+/**
+    @file include/small_vector.h
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief The definition of the SmallVector class template.
+
+    A growable array of trivially copyable values that keeps its first
+    N elements inline and only allocates once it outgrows them.
+*/
+#ifndef INCLUDE_SMALL_VECTOR_H
+#define INCLUDE_SMALL_VECTOR_H
+
+#include "span.h"
+#include <algorithm>  // copy_n
+#include <cstddef>  // size_t
+#include <cstdint>  // uint32_t
+#include <memory>  // unique_ptr
+#include <type_traits>  // is_trivially_copyable
+#include <utility>  // move
+
+namespace pabo {
+
+template<typename T, std::size_t N>
+class SmallVector {
+    static_assert(std::is_trivially_copyable_v<T>);
+    static_assert(N > 0);
+
+public:
+    SmallVector() = default;
+    SmallVector(const SmallVector& other);
+    SmallVector(SmallVector&& other) noexcept;
+    SmallVector& operator=(const SmallVector& other);
+    SmallVector& operator=(SmallVector&& other) noexcept;
+    ~SmallVector() = default;
+
+    void push_back(const T& value);
+
+    [[nodiscard]] T* data() noexcept;
+    [[nodiscard]] const T* data() const noexcept;
+    [[nodiscard]] std::size_t size() const noexcept;
+    [[nodiscard]] bool empty() const noexcept;
+
+    [[nodiscard]] T* begin() noexcept;
+    [[nodiscard]] T* end() noexcept;
+    [[nodiscard]] const T* begin() const noexcept;
+    [[nodiscard]] const T* end() const noexcept;
+
+    [[nodiscard]] Span<const T> view() const noexcept;
+
+private:
+    void grow();
+
+    T m_inline[N]{};
+    std::unique_ptr<T[]> m_heap;
+    std::uint32_t m_size{0};
+    std::uint32_t m_capacity{N};
+};
+
+template<typename T, std::size_t N>
+SmallVector<T, N>::SmallVector(const SmallVector& other)
+{
+    *this = other;
+}
+
+template<typename T, std::size_t N>
+SmallVector<T, N>& SmallVector<T, N>::operator=(const SmallVector& other)
+{
+    if (this == &other) {
+        return *this;
+    }
+    if (other.m_size > N) {
+        m_heap = std::make_unique<T[]>(other.m_size);
+        m_capacity = other.m_size;
+    }
+    else {
+        m_heap.reset();
+        m_capacity = N;
+    }
+    m_size = other.m_size;
+    std::copy_n(other.data(), m_size, data());
+    return *this;
+}
+
+template<typename T, std::size_t N>
+SmallVector<T, N>::SmallVector(SmallVector&& other) noexcept
+{
+    *this = std::move(other);
+}
+
+template<typename T, std::size_t N>
+SmallVector<T, N>& SmallVector<T, N>::operator=(SmallVector&& other) noexcept
+{
+    if (this == &other) {
+        return *this;
+    }
+    std::copy_n(other.m_inline, N, m_inline);
+    m_heap = std::move(other.m_heap);
+    m_size = other.m_size;
+    m_capacity = other.m_capacity;
+    other.m_size = 0;
+    other.m_capacity = N;
+    return *this;
+}
+
+template<typename T, std::size_t N>
+void SmallVector<T, N>::push_back(const T& value)
+{
+    if (m_size == m_capacity) {
+        grow();
+    }
+    data()[m_size++] = value;
+}
+
+template<typename T, std::size_t N>
+void SmallVector<T, N>::grow()
+{
+    const auto capacity = m_capacity * 2;
+    auto heap = std::make_unique<T[]>(capacity);
+    std::copy_n(data(), m_size, heap.get());
+    m_heap = std::move(heap);
+    m_capacity = capacity;
+}
+
+template<typename T, std::size_t N>
+T* SmallVector<T, N>::data() noexcept
+{
+    return m_heap ? m_heap.get() : m_inline;
+}
+
+template<typename T, std::size_t N>
+const T* SmallVector<T, N>::data() const noexcept
+{
+    return m_heap ? m_heap.get() : m_inline;
+}
+
+template<typename T, std::size_t N>
+std::size_t SmallVector<T, N>::size() const noexcept
+{
+    return m_size;
+}
+
+template<typename T, std::size_t N>
+bool SmallVector<T, N>::empty() const noexcept
+{
+    return m_size == 0;
+}
+
+template<typename T, std::size_t N>
+T* SmallVector<T, N>::begin() noexcept
+{
+    return data();
+}
+
+template<typename T, std::size_t N>
+T* SmallVector<T, N>::end() noexcept
+{
+    return data() + m_size;
+}
+
+template<typename T, std::size_t N>
+const T* SmallVector<T, N>::begin() const noexcept
+{
+    return data();
+}
+
+template<typename T, std::size_t N>
+const T* SmallVector<T, N>::end() const noexcept
+{
+    return data() + m_size;
+}
+
+template<typename T, std::size_t N>
+Span<const T> SmallVector<T, N>::view() const noexcept
+{
+    return {data(), m_size};
+}
+
+}  // namespace pabo
+
+#endif
@@ -0,0 +1,42 @@
+/**
+    @file include/span.h
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief The definition of the Span class template.
+
+    A non-owning view of a contiguous sequence, standing in for
+    std::span until the project moves past C++17.
+*/
+#ifndef INCLUDE_SPAN_H
+#define INCLUDE_SPAN_H
+
+#include <cstddef>  // size_t
+
+namespace pabo {
+
+template<typename T>
+class Span {
+public:
+    using value_type = T;
+    using iterator = T*;
+
+    constexpr Span() noexcept = default;
+    constexpr Span(T* first, std::size_t count) noexcept
+        : m_data{first}, m_size{count} {}
+
+    [[nodiscard]] constexpr T* begin() const noexcept { return m_data; }
+    [[nodiscard]] constexpr T* end() const noexcept { return m_data + m_size; }
+    [[nodiscard]] constexpr T* data() const noexcept { return m_data; }
+    [[nodiscard]] constexpr std::size_t size() const noexcept { return m_size; }
+    [[nodiscard]] constexpr bool empty() const noexcept { return m_size == 0; }
+    [[nodiscard]] constexpr T& operator[](std::size_t i) const { return m_data[i]; }
+
+private:
+    T* m_data{nullptr};
+    std::size_t m_size{0};
+};
+
+}  // namespace pabo
+
+#endif
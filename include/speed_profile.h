@@ -0,0 +1,60 @@
+/**
+    @file include/speed_profile.h
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief The definition of the SpeedProfile class.
+
+    The speed limits along a route. A train keeps its own speed on the
+    route but slows down to the limit of every path that has a lower
+    one, so the travel time is the sum of the times of the paths.
+
+    The paths are merged by limit when the profile is made, so both
+    the travel time at a speed and the speed for a travel time are
+    found with a search over the distinct limits of the route.
+*/
+#ifndef INCLUDE_SPEED_PROFILE_H
+#define INCLUDE_SPEED_PROFILE_H
+
+#include "capacity.h"
+#include "time_point.h"
+#include <vector>
+
+namespace pabo::train {
+
+class SpeedProfile {
+public:
+    using Distance = Capacity<double>;
+    using Speed = Capacity<double>;
+    using Duration = time::TimeOfDay;
+
+    // A path of the route. A path without a limit has an infinite one.
+    struct Segment {
+        double distance;
+        double speedLimit;
+    };
+
+    SpeedProfile() = default;
+    explicit SpeedProfile(const std::vector<Segment>& segments);
+
+    [[nodiscard]] Distance distance() const;
+    // The time to run the route at a speed.
+    [[nodiscard]] Duration travelTime(const Speed& speed) const;
+    // The lowest speed that runs the route in a travel time. Throws
+    // invalid_argument if the limits make the route take longer.
+    [[nodiscard]] Speed speedFor(const Duration& travelTime) const;
+
+private:
+    // The distinct limits of the route in increasing order.
+    std::vector<double> m_limits;
+    // The distance, and the hours it takes at the limits, of the
+    // paths with a limit below each of m_limits. One more element
+    // than m_limits, the last for all the limited paths.
+    std::vector<double> m_slowDistance{0.0};
+    std::vector<double> m_slowHours{0.0};
+    double m_distance{0.0};
+};
+
+}  // namespace pabo::train
+
+#endif
@@ -0,0 +1,94 @@
+/**
+    @file include/spsc_ring.h
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief The definition of the SpscRing class template.
+
+    A bounded lock-free queue for exactly one producer thread and one
+    consumer thread.
+*/
+#ifndef INCLUDE_SPSC_RING_H
+#define INCLUDE_SPSC_RING_H
+
+#include <atomic>
+#include <cstddef>  // size_t
+#include <optional>
+#include <utility>  // move
+#include <vector>
+
+namespace pabo::app {
+
+template<typename T>
+class SpscRing {
+public:
+    // The capacity is rounded up to a power of two.
+    explicit SpscRing(std::size_t capacity);
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    [[nodiscard]] std::size_t capacity() const noexcept;
+
+    // Producer. Returns false, leaving the value untouched, if the
+    // ring is full.
+    [[nodiscard]] bool tryPush(T& value);
+
+    // Consumer. Returns nothing if the ring is empty.
+    [[nodiscard]] std::optional<T> tryPop();
+
+private:
+    static constexpr std::size_t cacheLine{64};
+
+    std::vector<T> m_slots;
+    std::size_t m_mask;
+    // The next slot to pop, written by the consumer only.
+    alignas(cacheLine) std::atomic<std::size_t> m_head{0};
+    // The next slot to push, written by the producer only.
+    alignas(cacheLine) std::atomic<std::size_t> m_tail{0};
+};
+
+template<typename T>
+SpscRing<T>::SpscRing(std::size_t capacity)
+{
+    auto size = std::size_t{1};
+    while (size < capacity) {
+        size *= 2;
+    }
+    m_slots.resize(size);
+    m_mask = size - 1;
+}
+
+template<typename T>
+std::size_t SpscRing<T>::capacity() const noexcept
+{
+    return m_slots.size();
+}
+
+template<typename T>
+bool SpscRing<T>::tryPush(T& value)
+{
+    const auto tail = m_tail.load(std::memory_order_relaxed);
+    if (tail - m_head.load(std::memory_order_acquire) == m_slots.size()) {
+        return false;
+    }
+    m_slots[tail & m_mask] = std::move(value);
+    m_tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+template<typename T>
+std::optional<T> SpscRing<T>::tryPop()
+{
+    const auto head = m_head.load(std::memory_order_relaxed);
+    if (head == m_tail.load(std::memory_order_acquire)) {
+        return std::nullopt;
+    }
+    auto res = std::optional<T>{std::move(m_slots[head & m_mask])};
+    m_head.store(head + 1, std::memory_order_release);
+    return res;
+}
+
+}  // namespace pabo::app
+
+#endif
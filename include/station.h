@@ -8,11 +8,18 @@
 #ifndef INCLUDE_STATION_H
 #define INCLUDE_STATION_H
 
+#include "platform_occupancy.h"
+#include "station_id.h"
+#include "time_point.h"
 #include "vehicle.h"
 #include "vehicle_type.h"
+#include <array>
+#include <functional>  // function
 #include <iosfwd>
 #include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace pabo::train {
@@ -24,6 +31,14 @@ public:
     // A CarView is a read-only view of a Car;
     using CarView = const Vehicle*;
 
+    // An incomplete train that waits for cars to arrive instead of
+    // retrying its assembly.
+    struct Waiter {
+        int trainNbr;
+        // The time of the attempt that the train skips first.
+        time::TimeOfDay nextAttempt;
+    };
+
     //
     // Construct
     //
@@ -33,16 +48,25 @@ public:
     //
     // Queries
     //
-    [[nodiscard]] std::string name() const;
+    [[nodiscard]] StationId id() const noexcept;
+    [[nodiscard]] std::string_view name() const;
     [[nodiscard]] bool hasCar(CarType) const;
     [[nodiscard]] bool hasCar(int id) const;
     [[nodiscard]] int carCount() const noexcept;
+    [[nodiscard]] int carCount(CarType) const;
     [[nodiscard]] bool isEmpty() const noexcept;
     // Returns a read only view of the car with given id.
     // Throws std::out_of_range if no such car exists in the pool
     [[nodiscard]] CarView viewCar(int id) const;
     // Returns a vector of the cars in the pool.
     [[nodiscard]] std::vector<CarView> availableCars() const;
+    // Returns the cars of a type in the pool, lowest id first.
+    [[nodiscard]] std::vector<CarView> availableCars(CarType) const;
+    // Returns the car of a type with the lowest id, or nullptr if there
+    // is no car of the type in the pool.
+    [[nodiscard]] CarView firstCar(CarType) const;
+    // The platforms and the trains at them, see platform_occupancy.h.
+    [[nodiscard]] const PlatformOccupancy& platforms() const noexcept;
 
     //
     // Commands
@@ -53,16 +77,52 @@ public:
     // Returns a Car of type CarType.
     // Throws std::out_of_range if no such car exists in the pool
     [[nodiscard]] Car getCar(CarType);
+    // Returns the car with given id.
+    // Throws std::out_of_range if no such car exists in the pool
+    [[nodiscard]] Car getCar(int id);
+    // Removes the car with given id from the pool.
+    // Throws std::out_of_range if no such car exists in the pool
+    void removeCar(int id);
+
+    // Puts a train on the waitlist of each of the types.
+    void addWaiter(const Waiter& w, const std::vector<CarType>& types);
+    // Removes and returns the trains that wait for a type that is now
+    // in the pool and that are accepted by the predicate. A train is
+    // removed from every waitlist it is on.
+    [[nodiscard]] std::vector<Waiter> wakeWaiters(const std::function<bool(const Waiter&)>& accept);
+    // Removes and returns every waiting train.
+    [[nodiscard]] std::vector<Waiter> takeWaiters();
+
+    // Sets the number of platforms, 0 for no limit. Only done before
+    // the simulation starts, the trains at the platforms are lost.
+    void setPlatformCount(int platforms);
+    // Takes a platform for a train, or puts the train last in the
+    // platform queue if every platform is taken.
+    [[nodiscard]] bool takePlatform(time::TimeOfDay time, int trainNbr);
+    // Leaves a platform and gives it to the first train in the platform
+    // queue, if it is accepted by the predicate.
+    [[nodiscard]] std::optional<PlatformOccupancy::Waiter> leavePlatform(
+            time::TimeOfDay time,
+            const std::function<bool(const PlatformOccupancy::Waiter&)>& accept);
+    // Removes and returns every train waiting for a platform.
+    [[nodiscard]] std::vector<PlatformOccupancy::Waiter> takePlatformWaiters();
 
 private:
     [[nodiscard]] auto findCarByType(CarType);
     void remove(std::vector<Car>::iterator);
     void sortPoolById();
 
-    std::string m_name;
+    void removeWaiter(int trainNbr);
+
+    StationId m_id{noStation};
     std::vector<Car> m_self;
+    // Indexed by the position of the type in vehicleTypes.
+    std::array<std::vector<Waiter>, vehicleTypes.size()> m_waitlists;
+    PlatformOccupancy m_platforms;
 };
 
+// Reads a station from a line with its name, an optional number of
+// platforms and the cars of its pool.
 std::istream& operator>>(std::istream&, Station&);
 
 }  // namespace pabo::train
@@ -0,0 +1,37 @@
+/**
+    @file include/station_id.h
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief The interned station names.
+
+    A station is identified by a small integer instead of by its name.
+    The names are interned into one table for the whole program when
+    the data is read, so the same name has the same id in every
+    dispatcher, log and thread. The rest of the program compares ids
+    and only turns them back into names to print them.
+*/
+#ifndef INCLUDE_STATION_ID_H
+#define INCLUDE_STATION_ID_H
+
+#include <cstdint>  // uint16_t
+#include <string_view>
+
+namespace pabo::train {
+
+using StationId = std::uint16_t;
+
+// The id of the empty name, used by objects that have no station.
+constexpr StationId noStation{0};
+
+// Returns the id of a name, adding the name on first use. Safe to call
+// from any thread. Throws length_error if there are too many names.
+[[nodiscard]] StationId internStation(std::string_view name);
+
+// Returns the name of an id. The view is valid for the rest of the
+// program. Throws out_of_range if no name has the id.
+[[nodiscard]] std::string_view stationName(StationId id);
+
+}  // namespace pabo::train
+
+#endif
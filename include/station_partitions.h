@@ -0,0 +1,102 @@
+/**
+    @file include/station_partitions.h
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief The definition of the StationPartitions class.
+
+    Splits the pending events of a simulation into one partition per
+    station. An event belongs to the station where it takes place: the
+    origin of its train up until the departure and the destination
+    from the arrival onward. The car pool of a station is only touched
+    by the events of its own partition.
+
+    The only event that crosses partitions is the arrival scheduled by
+    a departure, and it can not happen sooner than the shortest travel
+    time of the network (the lookahead) after the departure. All
+    partitions can therefore process the events of a window that is
+    one lookahead long without waiting for each other.
+*/
+#ifndef INCLUDE_STATION_PARTITIONS_H
+#define INCLUDE_STATION_PARTITIONS_H
+
+#include "car_log.h"
+#include "event.h"
+#include "event_hooks.h"
+#include "event_sites.h"
+#include "time_point.h"
+#include "train_log.h"
+#include <cstddef>  // size_t
+#include <memory>  // shared_ptr, unique_ptr
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <vector>
+
+namespace pabo::train {
+class TrainDispatcher;
+}
+
+namespace pabo::app {
+
+class ThreadPool;
+
+class StationPartitions {
+public:
+    using EventPtr = std::shared_ptr<train::Event>;
+
+    StationPartitions(const train::TrainDispatcher& disp, const EventHooks& hooks);
+
+    // Adds an event to the partition of the station where it takes
+    // place. Safe to call from the events of any partition.
+    // Throws logic_error if the event belongs to no station, or to
+    // another partition and is earlier than the end of the window.
+    void schedule(EventPtr event);
+
+    // The time of the earliest pending event in any partition.
+    [[nodiscard]] std::optional<time::TimeOfDay> nextEventTime();
+
+    // Processes every event earlier than the end of the window. Each
+    // partition is one task in the pool.
+    void runWindow(ThreadPool& pool, time::TimeOfDay windowEnd);
+
+    // The time of the last processed event.
+    [[nodiscard]] time::TimeOfDay lastEventTime() const;
+
+    // Returns the number of high priority events processed since the
+    // last call.
+    [[nodiscard]] int takeHighPriorityCount();
+
+    // Moves the records logged by the partitions into the logs. After a
+    // window, the records of the window are complete.
+    void mergeLogs(train::TrainLog& log, train::CarLog& carLog);
+
+private:
+    struct Partition;
+
+    [[nodiscard]] Partition& partitionOf(const train::Event& event);
+    void runPartition(Partition& p);
+    static void deliver(Partition& p);
+
+    const EventHooks& m_hooks;
+    EventSites m_sites;
+    std::vector<std::unique_ptr<Partition>> m_partitions;
+    time::TimeOfDay m_windowEnd{0};
+};
+
+struct StationPartitions::Partition {
+    std::priority_queue<EventPtr, std::vector<EventPtr>, train::EventComparison> queue;
+    // Events scheduled by other partitions, moved to the queue by the
+    // thread running this partition.
+    std::mutex inboxMutex;
+    std::vector<EventPtr> inbox;
+
+    train::TrainLog log;
+    train::CarLog carLog;
+    time::TimeOfDay lastEventTime{0};
+    int highPriorityCount{0};
+};
+
+}  // namespace pabo::app
+
+#endif
@@ -0,0 +1,68 @@
+/**
+    @file include/thread_pool.h
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief The definition of the ThreadPool class.
+
+    A fixed set of worker threads that runs indexed tasks. The calling
+    thread takes part in the work, so a pool of size one runs every
+    task on the caller.
+*/
+#ifndef INCLUDE_THREAD_POOL_H
+#define INCLUDE_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>  // size_t
+#include <cstdint>  // uint64_t
+#include <exception>  // exception_ptr
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace pabo::app {
+
+class ThreadPool {
+public:
+    using Task = std::function<void(std::size_t)>;
+
+    // A size of zero uses one thread per hardware thread.
+    explicit ThreadPool(unsigned size = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool(ThreadPool&&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ThreadPool& operator=(ThreadPool&&) = delete;
+
+    // The number of threads, including the calling thread.
+    [[nodiscard]] unsigned size() const noexcept;
+
+    // Calls task(i) for every i in [0, count) and returns when all
+    // calls have returned. The first exception thrown by a task is
+    // rethrown here.
+    void parallelFor(std::size_t count, const Task& task);
+
+private:
+    void work();
+    void runTasks();
+
+    std::vector<std::thread> m_workers;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_done;
+
+    const Task* m_task{nullptr};
+    std::size_t m_count{0};
+    std::atomic<std::size_t> m_next{0};
+    std::size_t m_busy{0};
+    std::uint64_t m_generation{0};
+    bool m_stopping{false};
+    std::exception_ptr m_error;
+};
+
+}  // namespace pabo::app
+
+#endif
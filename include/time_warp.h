@@ -0,0 +1,134 @@
+/**
+    @file include/time_warp.h
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief The definition of the TimeWarp class.
+
+    Optimistic parallel execution of the events, partitioned by
+    station like StationPartitions. Each partition runs ahead of the
+    others without waiting for the arrivals that they may send. A
+    partition that receives an arrival earlier than events it has
+    already processed (a straggler) rolls back: the processed events
+    are undone by restoring the saved states of the station and the
+    trains, and the events they scheduled are cancelled, which may in
+    turn roll back other partitions.
+
+    The partitions run in rounds on the thread pool. During a round
+    they only touch their own station and trains, the arrivals for
+    other partitions are exchanged between the rounds. Events earlier
+    than the global virtual time, the earliest pending event, can no
+    longer be rolled back and are committed to the logs.
+*/
+#ifndef INCLUDE_TIME_WARP_H
+#define INCLUDE_TIME_WARP_H
+
+#include "car_log.h"
+#include "event.h"
+#include "event_hooks.h"
+#include "event_sites.h"
+#include "station.h"
+#include "time_point.h"
+#include "train.h"
+#include "train_log.h"
+#include <cstddef>  // size_t
+#include <deque>
+#include <memory>  // shared_ptr, unique_ptr
+#include <optional>
+#include <set>
+#include <unordered_set>
+#include <vector>
+
+namespace pabo::train {
+class TrainDispatcher;
+}
+
+namespace pabo::app {
+
+class ThreadPool;
+
+class TimeWarp {
+public:
+    using EventPtr = std::shared_ptr<train::Event>;
+    using Duration = time::TimeOfDay;
+
+    // A round processes the events that are earlier than the global
+    // virtual time plus the window.
+    TimeWarp(train::TrainDispatcher& disp, const EventHooks& hooks, Duration window);
+
+    // Adds an event to the partition of the station where it takes
+    // place. Safe to call from the events of any partition.
+    // Throws logic_error if the event belongs to no station.
+    void schedule(EventPtr event);
+
+    [[nodiscard]] bool hasPendingEvents() const;
+
+    // Processes one round and commits the events that can no longer
+    // be rolled back. Everything is committed when no events remain.
+    void runRound(ThreadPool& pool);
+
+    // The time of the last committed event.
+    [[nodiscard]] time::TimeOfDay lastEventTime() const;
+
+    // The number of processed events that have been undone.
+    [[nodiscard]] std::size_t rolledBackEvents() const noexcept;
+
+    // Moves the records of the committed events into the logs.
+    void mergeLogs(train::TrainLog& log, train::CarLog& carLog);
+
+private:
+    // Orders events by time and then by train number.
+    struct EventOrder {
+        bool operator()(const EventPtr& lhs, const EventPtr& rhs) const;
+    };
+
+    // A processed event, together with what is needed to undo it.
+    struct Record {
+        EventPtr event;
+        train::Station station;
+        train::Train train;
+        std::vector<EventPtr> children;
+        train::TrainLog log;
+        train::CarLog carLog;
+    };
+
+    struct Partition {
+        std::size_t idx;
+        std::set<EventPtr, EventOrder> pending;
+        std::deque<Record> processed;
+        // Events for other partitions, exchanged after the round.
+        std::vector<EventPtr> outbox;
+
+        train::TrainLog log;
+        train::CarLog carLog;
+        time::TimeOfDay lastEventTime{0};
+    };
+
+    [[nodiscard]] Partition& partitionOf(const train::Event& event);
+    [[nodiscard]] std::optional<EventPtr> globalVirtualTime() const;
+
+    void runPartition(Partition& p, time::TimeOfDay horizon);
+    void exchangeMessages();
+    void deliver(EventPtr event);
+    void cancel(const EventPtr& event);
+    void rollback(Partition& p, const train::Event& straggler);
+    void undoLast(Partition& p);
+    void commit(Partition& p, const EventPtr& gvt);
+    void commitFirst(Partition& p);
+
+    static thread_local Partition* s_currentPartition;
+    static thread_local Record* s_currentRecord;
+
+    train::TrainDispatcher& m_disp;
+    const EventHooks& m_hooks;
+    EventSites m_sites;
+    Duration m_window;
+    std::vector<std::unique_ptr<Partition>> m_partitions;
+    // Cancelled events that have not been delivered yet.
+    std::unordered_set<const train::Event*> m_cancelled;
+    std::size_t m_rolledBack{0};
+};
+
+}  // namespace pabo::app
+
+#endif
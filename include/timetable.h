@@ -0,0 +1,75 @@
+/**
+    @file include/timetable.h
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief The definition of the Timetable class.
+
+    An index of the connections by station. The departures of every
+    station are kept in order of scheduled departure and the arrivals
+    in order of scheduled arrival, in one array each with the stations
+    one after the other. The connections of a station are therefore a
+    contiguous span, and the ones in an interval of time are found
+    with a binary search instead of a scan of every connection.
+*/
+#ifndef INCLUDE_TIMETABLE_H
+#define INCLUDE_TIMETABLE_H
+
+#include "span.h"
+#include "station_id.h"
+#include "time_point.h"
+#include "train_connection.h"
+#include <cstddef>  // size_t
+#include <vector>
+
+namespace pabo::train {
+
+class Timetable {
+public:
+    // A connection, by its position in the timetable, at its scheduled
+    // time of departure or arrival.
+    struct Entry {
+        time::TimeOfDay scheduled;
+        std::size_t connection;
+    };
+    using Entries = Span<const Entry>;
+
+    Timetable() = default;
+    explicit Timetable(const std::vector<TrainConnection>& connections);
+
+    // The connections that leave a station, in order of scheduled
+    // departure. Connections with the same time keep their order in
+    // the timetable.
+    [[nodiscard]] Entries departuresFrom(StationId id) const noexcept;
+    // The departures in [from, to).
+    [[nodiscard]] Entries departuresFrom(StationId id, time::TimeOfDay from,
+                                         time::TimeOfDay to) const;
+    // The connections that reach a station, in order of scheduled
+    // arrival.
+    [[nodiscard]] Entries arrivalsAt(StationId id) const noexcept;
+    // The arrivals in [from, to).
+    [[nodiscard]] Entries arrivalsAt(StationId id, time::TimeOfDay from,
+                                     time::TimeOfDay to) const;
+
+private:
+    struct Index {
+        std::vector<Entry> entries;
+        // The position in entries of the first connection of each
+        // station, by station id, and one past the last.
+        std::vector<std::size_t> first;
+    };
+
+    template<typename StationOf, typename TimeOf>
+    [[nodiscard]] static Index makeIndex(const std::vector<TrainConnection>& connections,
+                                         StationOf stationOf, TimeOf timeOf);
+    [[nodiscard]] static Entries all(const Index& index, StationId id) noexcept;
+    [[nodiscard]] static Entries range(const Index& index, StationId id,
+                                       time::TimeOfDay from, time::TimeOfDay to);
+
+    Index m_departures;
+    Index m_arrivals;
+};
+
+}  // namespace pabo::train
+
+#endif
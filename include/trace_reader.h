@@ -0,0 +1,70 @@
+/**
+    @file include/trace_reader.h
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief The definition of the TraceReader class.
+
+    Maps an event trace, see event_trace.h, into memory and exposes
+    its columns as arrays without copying or parsing them.
+*/
+#ifndef INCLUDE_TRACE_READER_H
+#define INCLUDE_TRACE_READER_H
+
+#include <cstddef>  // size_t
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace pabo::train {
+
+class TraceReader {
+public:
+    // The columns of a chunk, each with size elements.
+    struct Chunk {
+        std::size_t size;
+        const std::int32_t* time;
+        const std::int32_t* trainNbr;
+        const std::int32_t* departureDelay;
+        const std::int32_t* arrivalDelay;
+        const float* speed;
+        const std::uint16_t* station;
+        // EventType values.
+        const std::uint8_t* type;
+        // Train::State values.
+        const std::uint8_t* state;
+    };
+
+    // Throws runtime_error if the file can not be mapped or is not a
+    // valid trace.
+    explicit TraceReader(const std::string& filename);
+    ~TraceReader();
+
+    TraceReader(TraceReader&& other) noexcept;
+    TraceReader& operator=(TraceReader&& other) noexcept;
+    TraceReader(const TraceReader&) = delete;
+    TraceReader& operator=(const TraceReader&) = delete;
+
+    [[nodiscard]] const std::vector<std::string>& stationNames() const noexcept;
+    // The number of events in the trace.
+    [[nodiscard]] std::size_t size() const noexcept;
+    [[nodiscard]] std::size_t chunkCount() const noexcept;
+    // Throws out_of_range if there is no such chunk.
+    [[nodiscard]] Chunk chunk(std::size_t idx) const;
+
+private:
+    void unmap() noexcept;
+    void readHeader();
+
+    const char* m_data{nullptr};
+    std::size_t m_length{0};
+    std::vector<std::string> m_stationNames;
+    std::size_t m_chunkRows{0};
+    std::size_t m_firstChunk{0};
+    std::size_t m_chunkCount{0};
+    std::size_t m_size{0};
+};
+
+}  // namespace pabo::train
+
+#endif
@@ -0,0 +1,60 @@
+/**
+    @file include/track_occupancy.h
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief The definition of the TrackOccupancy class.
+
+    The times at which the tracks of one path are taken by trains. A
+    path has a fixed number of tracks and a train takes one of them
+    for the whole time that it runs on the path, in either direction.
+
+    Each track keeps its intervals in a tree ordered by start, the
+    intervals of a track never overlap. Whether a train can take a
+    track at a time, and which trains are on the path at a time, is
+    therefore a search per track and not a scan of the trains.
+*/
+#ifndef INCLUDE_TRACK_OCCUPANCY_H
+#define INCLUDE_TRACK_OCCUPANCY_H
+
+#include <map>
+#include <vector>
+
+namespace pabo::train {
+
+class TrackOccupancy {
+public:
+    // Throws invalid_argument if the number of tracks is not positive.
+    explicit TrackOccupancy(int tracks = 1);
+
+    [[nodiscard]] int tracks() const noexcept;
+
+    // Whether a track is free in [begin, end).
+    [[nodiscard]] bool isFree(int begin, int end) const;
+    // The earliest time at or after begin at which a track is free
+    // for the length.
+    [[nodiscard]] int earliestFree(int begin, int length) const;
+    // Takes a track in [begin, end) for a train. Throws logic_error if
+    // no track is free and invalid_argument if the interval is empty.
+    void reserve(int begin, int end, int trainNbr);
+
+    // The trains on the path at a time.
+    [[nodiscard]] std::vector<int> trainsAt(int time) const;
+
+private:
+    struct Interval {
+        int end;
+        int trainNbr;
+    };
+    // The intervals of a track by their start.
+    using Track = std::map<int, Interval>;
+
+    [[nodiscard]] static bool isFree(const Track& track, int begin, int end);
+    [[nodiscard]] static int earliestFree(const Track& track, int begin, int length);
+
+    std::vector<Track> m_tracks;
+};
+
+}  // namespace pabo::train
+
+#endif
@@ -14,6 +14,7 @@
 #include "train_connection.h"
 #include "vehicle.h"
 #include "vehicle_type.h"
+#include <array>
 #include <iosfwd>
 #include <memory>  // unique_ptr
 #include <string>
@@ -57,8 +58,12 @@ public:
     // The time of the departure time of this train.
     [[nodiscard]] time::TimeOfDay departure() const noexcept;
 
+    // The time that the train has waited for a platform at its
+    // destination.
+    [[nodiscard]] Duration arrivalWait() const noexcept;
+
     // Returns true if the vector returned by missingCarTypes
-    // is empty.
+    // is empty. Constant time.
     [[nodiscard]] bool isAssembled() const noexcept;
 
     // Returns true of the state of the train is running, arrived
@@ -72,8 +77,11 @@ public:
     // train.
     [[nodiscard]] std::vector<CarType> missingCarTypes() const;
 
+    // The number of empty slots of a type. Constant time.
+    [[nodiscard]] int missingCount(CarType) const noexcept;
+
     // Car queries for this train.
-    [[nodiscard]] bool missesCarOfType(CarType) const;
+    [[nodiscard]] bool missesCarOfType(CarType) const noexcept;
     [[nodiscard]] bool hasCar(int id) const;
 
     // Returns a read-only view of the car with given id.
@@ -85,7 +93,8 @@ public:
     // the train.
     [[nodiscard]] std::vector<CarView> attachedCars() const;
 
-    // Returns the speed of the slowest of the trains cars.
+    // Returns the speed of the slowest of the trains locomotives, or
+    // zero if there is none. Constant time.
     [[nodiscard]] Speed maxSpeed() const;
 
     // Returns the current speed of the train.
@@ -102,6 +111,9 @@ public:
     // Delay the trains departure time.
     void delayDeparture(int minutes);
 
+    // Delay the trains arrival, after the time it takes to run.
+    void delayArrival(int minutes);
+
     // Attach a car to the train.
     // A runtime_error exception is thrown if the car is not of a
     // type that is returned by missesCarOfType.
@@ -138,8 +150,15 @@ private:
     time::TimeOfDay m_departure;
     Duration m_departureDelay;
     Duration m_arrivalDelay;
+    Duration m_arrivalWait;
     std::vector<Slot> m_self;
     Speed m_currentSpd{0.0, "kph"};
+
+    // Kept up to date by attachCar and disassemble.
+    std::array<int, vehicleTypes.size()> m_missing{};
+    int m_missingTotal{0};
+    bool m_hasEngine{false};
+    Speed m_maxSpd{0.0, "kph"};
 };
 
 enum class Train::State {
@@ -152,6 +171,14 @@ enum class Train::State {
     finished,
 };
 
+// Every state, in the order a train passes through them.
+inline constexpr std::array<Train::State, 7> trainStates{
+        Train::State::not_assembled, Train::State::assembled,
+        Train::State::incomplete, Train::State::ready,
+        Train::State::running, Train::State::arrived,
+        Train::State::finished};
+
+[[nodiscard]] std::string toString(Train::State);
 std::ostream& operator<<(std::ostream&, Train::State);
 
 }  // namespace pabo::train
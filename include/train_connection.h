@@ -12,6 +12,7 @@
 #define INCLUDE_TRAIN_CONNECTION_H
 
 #include "capacity.h"
+#include "station_id.h"
 #include "time_point.h"
 #include "vehicle.h"
 #include "vehicle_type.h"
@@ -29,8 +30,8 @@ public:
     TrainConnection(std::string);
 
     [[nodiscard]] int trainNbr() const;
-    [[nodiscard]] std::string origin() const;
-    [[nodiscard]] std::string destination() const;
+    [[nodiscard]] StationId origin() const;
+    [[nodiscard]] StationId destination() const;
     [[nodiscard]] time::TimeOfDay departure() const;
     [[nodiscard]] time::TimeOfDay arrival() const;
     [[nodiscard]] Capacity<double> maxSpeed() const;
@@ -38,8 +39,8 @@ public:
 
 private:
     int m_nbr{0};
-    std::string m_origin;
-    std::string m_destination;
+    StationId m_origin{noStation};
+    StationId m_destination{noStation};
     time::TimeOfDay m_departure;
     time::TimeOfDay m_arrival;
     Speed m_maxSpeed;
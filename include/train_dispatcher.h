@@ -10,12 +10,24 @@
 #ifndef INCLUDE_TRAIN_DISPATCH_H
 #define INCLUDE_TRAIN_DISPATCH_H
 
+#include "allocation_policy.h"
 #include "capacity.h"
+#include "network.h"
 #include "path.h"
+#include "platform_occupancy.h"
+#include "speed_profile.h"
 #include "station.h"
+#include "station_id.h"
 #include "time_point.h"
+#include "timetable.h"
+#include "track_occupancy.h"
 #include "train.h"
 #include "train_connection.h"
+#include "train_tally.h"
+#include <cstddef>  // size_t
+#include <functional>  // function
+#include <memory>  // shared_ptr
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -39,6 +51,10 @@ public:
     TrainDispatcher(std::vector<ConnObj>,
                     std::vector<StationObj>,
                     std::vector<PathObj>);
+    // The network is shared, only the trains and the stations are
+    // owned by the dispatcher.
+    TrainDispatcher(std::shared_ptr<const Network>,
+                    std::vector<StationObj>);
 
     // Time queries
     [[nodiscard]] time::TimeOfDay estimatedTimeOfDeparture(int nbr) const;
@@ -61,6 +77,11 @@ public:
     [[nodiscard]] TrainView viewTrain(int nbr) const;
     [[nodiscard]] bool trainIsAssembled(int nbr) const;
     [[nodiscard]] bool allTrainsFinished() const;
+    [[nodiscard]] int finishedTrainCount() const;
+    // The number of trains, in total or in a given state. Constant
+    // time, so they may be polled to report progress.
+    [[nodiscard]] int trainCount() const;
+    [[nodiscard]] int trainCount(Train::State s) const;
     [[nodiscard]] std::string trainLocation(const Train& t) const;
     [[nodiscard]] TrainView viewTrainByVehicleId(int id) const;
 
@@ -73,57 +94,183 @@ public:
 
     // Connection queries
     [[nodiscard]] Distance distance(int nbr) const;
-    [[nodiscard]] std::string origin(int nbr) const;
-    [[nodiscard]] std::string destination(int nbr) const;
+    // The shortest possible travel time of any connection. No train
+    // can arrive sooner than this after its departure.
+    [[nodiscard]] Duration minimumTravelTime() const;
+    // Whether the map has a route between two stations, and the length
+    // of the shortest one. distance throws out_of_range if there is no
+    // route.
+    [[nodiscard]] bool hasPath(StationId from, StationId to) const;
+    [[nodiscard]] Distance distance(StationId from, StationId to) const;
+    // The time to run the route between two stations at a speed, with
+    // the speed limits of the route. Throws out_of_range if there is no
+    // route.
+    [[nodiscard]] Duration travelTime(StationId from, StationId to, const Speed& speed) const;
+    [[nodiscard]] StationId origin(int nbr) const;
+    [[nodiscard]] StationId destination(int nbr) const;
 
     // Station queries
+    [[nodiscard]] std::vector<StationId> stationIds() const;
     [[nodiscard]] std::vector<std::string> stationNames() const;
-    [[nodiscard]] StationView viewStation(const std::string& name) const;
-    [[nodiscard]] std::vector<const Train*> trainsAtStation(const std::string& name);
+    [[nodiscard]] StationView viewStation(StationId id) const;
+    // The trains at the station, in the order of the timetable.
+    [[nodiscard]] std::vector<const Train*> trainsAtStation(StationId id) const;
+    // The trains whose connection starts at the station, by scheduled
+    // time of departure.
+    struct Departure {
+        time::TimeOfDay scheduled;
+        const Train* train;
+    };
+    [[nodiscard]] std::vector<Departure> departuresFrom(StationId id) const;
+    // The connections of each station, see timetable.h. The train of
+    // an entry is found with viewTrain.
+    [[nodiscard]] const Timetable& timetable() const noexcept;
+    [[nodiscard]] TrainView viewTrain(const Timetable::Entry& entry) const;
+    [[nodiscard]] const TrainConnection& viewConnection(const Timetable::Entry& entry) const;
+    // The number of changes to the state or the delays of the train of
+    // an entry. A view of the train that was made at the same count is
+    // still up to date. Only the events of the train change it, so it
+    // is safe to count in the parallel modes.
+    [[nodiscard]] unsigned changeCount(const Timetable::Entry& entry) const;
 
     // Vehicle queries
     [[nodiscard]] std::vector<CarView> viewAllCars() const;
     [[nodiscard]] CarView viewCar(int id) const;
     [[nodiscard]] std::string carLocation(int id) const;
+    // The number of times the car has been attached to a train.
+    [[nodiscard]] int carUsage(int id) const;
 
     // Commands
+    // Attaches the cars that the train misses and that are available
+    // at its origin, chosen by the policy. The lowest ids are chosen
+    // if no policy is given.
     void tryAssembleTrain(int nbr);
+    void tryAssembleTrain(int nbr, const AllocationPolicy& policy);
     void disassembleTrain(int nbr);
+    // Puts an incomplete train on the waitlists of its origin if none
+    // of the cars it misses are available there, instead of retrying
+    // the assembly at the next attempt. Returns false, and does
+    // nothing, if a car that it misses is available.
+    [[nodiscard]] bool waitForCars(int nbr, time::TimeOfDay nextAttempt);
+    // Removes and returns the trains waiting at the station for cars
+    // that are now available, if accepted by the predicate.
+    [[nodiscard]] std::vector<Station::Waiter> wakeWaitingTrains(
+            StationId id,
+            const std::function<bool(const Station::Waiter&)>& accept);
+    // Removes and returns every waiting train of every station.
+    [[nodiscard]] std::vector<Station::Waiter> takeWaitingTrains();
+    // Takes up to count cars of the type out of the pool of a station,
+    // to be moved empty to another station. Returns the ids of the
+    // cars, which are in transit until they are received.
+    [[nodiscard]] std::vector<int> sendCars(StationId from, StationId to,
+                                            Vehicle::Type type, int count);
+    // Adds cars in transit to the pool of their destination.
+    void receiveCars(const std::vector<int>& ids);
     void setStateOfTrain(int nbr, Train::State s);
     void delayDeparture(int nbr, time::TimeOfDay delay);
+    // Delays the arrival of a running train, that waits for a platform.
+    void delayArrival(int nbr, time::TimeOfDay delay);
     void setDepartureDelay(int nbr);
     void setArrivalDelay(int nbr);
     void setOptimalSpeedOfTrain(int nbr);
 
+    // Track occupancy, see track_occupancy.h. A train takes a track of
+    // each path of its route while it runs on it. The tracks are not
+    // limited until a number of tracks per path is set, 0 for none.
+    void setTracksPerPath(int tracks);
+    // The earliest departure, at or after the estimated one, at which
+    // the train finds a free track on every path of its route at the
+    // speed it would run at.
+    [[nodiscard]] time::TimeOfDay earliestFreeDeparture(int nbr) const;
+    // Takes the tracks of the route of a train that departs at its
+    // current speed. Throws logic_error if a track is not free.
+    void reserveTracks(int nbr);
+    // The trains on the path between two stations at a time. Throws
+    // out_of_range if there is no such path.
+    [[nodiscard]] std::vector<int> trainsOnPath(StationId a, StationId b,
+                                                time::TimeOfDay time) const;
+
+    // Platforms, see platform_occupancy.h. A train takes a platform of
+    // a station, or is put last in its platform queue if every
+    // platform is taken, in which case false is returned.
+    [[nodiscard]] bool takePlatform(int nbr, StationId id, time::TimeOfDay time);
+    // Leaves a platform of a station and returns the waiting train that
+    // the platform is given to, if it is accepted by the predicate.
+    [[nodiscard]] std::optional<PlatformOccupancy::Waiter> leavePlatform(
+            StationId id, time::TimeOfDay time,
+            const std::function<bool(const PlatformOccupancy::Waiter&)>& accept);
+    // Removes and returns every train waiting for a platform.
+    [[nodiscard]] std::vector<PlatformOccupancy::Waiter> takePlatformWaiters();
+
+    // State saving, used to roll back events that were processed
+    // speculatively. A saved state is restored to the train or station
+    // with the same number or id.
+    [[nodiscard]] Train saveTrainState(int nbr) const;
+    void restoreTrainState(Train saved);
+    [[nodiscard]] Station saveStationState(StationId id) const;
+    void restoreStationState(Station saved);
+
 private:
     // Find operations
-    [[nodiscard]] auto findStationByName(const std::string& name) -> std::vector<StationObj>::iterator;
-    [[nodiscard]] auto findStationByName(const std::string& name) const -> std::vector<StationObj>::const_iterator;
+    [[nodiscard]] auto findStationById(StationId id) -> std::vector<StationObj>::iterator;
+    [[nodiscard]] auto findStationById(StationId id) const -> std::vector<StationObj>::const_iterator;
 
     [[nodiscard]] auto findTrainByNbr(int nbr) const -> std::vector<TrainObj>::const_iterator;
     [[nodiscard]] auto findTrainByNbr(int nbr) -> std::vector<TrainObj>::iterator;
 
     [[nodiscard]] auto findConnectionByNbr(int nbr) const -> std::vector<ConnObj>::const_iterator;
-    [[nodiscard]] auto findConnectionByNbr(int nbr) -> std::vector<ConnObj>::iterator;
+    [[nodiscard]] const SpeedProfile& profileOf(int nbr) const;
+
+    // The time that a train takes a path of its route, in minutes
+    // after its departure.
+    struct Block {
+        std::size_t path;
+        int begin;
+        int end;
+    };
+    [[nodiscard]] std::vector<Block> blocksOf(int nbr, const Speed& speed) const;
+
+    [[nodiscard]] std::size_t indexOf(std::vector<TrainObj>::const_iterator train) const;
+    // Tells the tally, and the change counts, about a change of a train.
+    void trainChanged(std::vector<TrainObj>::const_iterator train,
+                      const TrainTally::Entry& before);
+    // The station that the train is at, noStation while it is running.
+    [[nodiscard]] StationId stationOf(const Train& t) const;
 
     [[nodiscard]] Distance findDistance(int nbr) const;
-    [[nodiscard]] Distance findDistance(std::string station1,
-                                        std::string station2) const;
+    [[nodiscard]] Distance findDistance(StationId station1, StationId station2) const;
 
     [[nodiscard]] auto findCarById(int id) const;
     [[nodiscard]] auto findCarById(int id);
 
     // Calculations
+    [[nodiscard]] Speed optimalSpeed(const Train& t) const;
     [[nodiscard]] time::TimeOfDay calculateDelayOfStaticTrain(const Train& t) const;
     [[nodiscard]] time::TimeOfDay calculateDelayOfRunningTrain(const Train& t) const;
 
     // TODO Keep a cache for each vector to avoid unecessary find
     // operations.
 
+    std::shared_ptr<const Network> m_network{std::make_shared<const Network>()};
     std::vector<TrainObj> m_trains;
-    std::vector<ConnObj> m_connections;
     std::vector<StationObj> m_stations;
-    std::vector<PathObj> m_map;
+    // Must be told about every change to the state or the delays of a
+    // train in m_trains.
+    TrainTally m_tally;
+    // Indexed like m_trains, see changeCount.
+    std::vector<unsigned> m_changes;
+    // Indexed by car id. Every car exists from the start, so the size
+    // never changes and the parallel modes can count concurrently.
+    std::vector<int> m_carUsage;
+    // Cars that are moved empty, with the station they are moved to.
+    struct CarInTransit {
+        Station::Car car;
+        StationId destination;
+    };
+    std::vector<CarInTransit> m_inTransit;
+    // Indexed like the paths of the map, empty if the tracks are not
+    // limited.
+    std::vector<TrackOccupancy> m_occupancy;
 };
 
 //
@@ -8,20 +8,46 @@
 #ifndef INCLUDE_TRAIN_LOG_H
 #define INCLUDE_TRAIN_LOG_H
 
+#include "event_type.h"
+#include "station_id.h"
 #include "time_point.h"
 #include "train.h"
-#include <memory>  // shared_ptr
+#include <cstddef>  // size_t
+#include <deque>
+#include <functional>
 #include <string>
-#include <utility>  // move
+#include <utility>  // move, pair
 #include <vector>
 
 namespace pabo::train {
 
+class TrainDispatcher;
+
+// The printed fields of a train, computed once when it is logged so
+// that printing needs no lookups in the dispatcher.
+struct TrainSummary {
+    TrainSummary() = default;
+    TrainSummary(const Train& t, const TrainDispatcher& disp);
+
+    int number{0};
+    Train::State state{Train::State::not_assembled};
+    StationId origin{noStation};
+    StationId destination{noStation};
+    time::TimeOfDay scheduledDeparture;
+    time::TimeOfDay estimatedDeparture;
+    time::TimeOfDay scheduledArrival;
+    time::TimeOfDay estimatedArrival;
+    time::TimeOfDay departureDelay;
+    time::TimeOfDay arrivalDelay;
+    Train::Speed speed{0.0, "kph"};
+};
+
 struct TrainRecord {
     TrainRecord() = default;
-    TrainRecord(time::TimeOfDay tp, const Train& t, std::string desc)
+    TrainRecord(time::TimeOfDay tp, EventType type, TrainSummary t, std::string desc)
         : time{std::move(tp)}
-        , train{std::make_shared<const Train>(t)}
+        , type{type}
+        , train{std::move(t)}
         , eventDescription{std::move(desc)}
     {
     }
@@ -29,8 +55,10 @@ struct TrainRecord {
     // The time that the event occured
     time::TimeOfDay time;
 
-    // A snapshot of the trains state at the time of the event
-    std::shared_ptr<const Train> train{nullptr};
+    EventType type{EventType::assembly};
+
+    // The state of the train at the time of the event
+    TrainSummary train;
 
     // A description of the event.
     std::string eventDescription;
@@ -38,21 +66,40 @@ struct TrainRecord {
 
 class TrainLog {
 public:
+    using ConstIterator = std::deque<TrainRecord>::const_iterator;
+    // Receives every record that is added to the log.
+    using Sink = std::function<void(const TrainRecord&)>;
 
-    // Add the train record to the log
+    // Add the train record to the log. The log is kept ordered by
+    // time and then by train number.
     void log(TrainRecord tr);
 
+    // Move all records of another log into this log.
+    void merge(TrainLog other);
+
+    // Records are passed to the sinks as they are added, in order as
+    // long as they are added in order.
+    void addSink(Sink sink);
+    void clearSinks();
+    // Keep only the latest records, 0 keeps every record.
+    void setWindow(std::size_t records);
+
     // Return the records that occured after a given time and up
     // until (and including) a given time.
     std::vector<TrainRecord> view(time::TimeOfDay from, time::TimeOfDay to);
+    // The same records as view, without copying them.
+    [[nodiscard]] std::pair<ConstIterator, ConstIterator> range(time::TimeOfDay from,
+                                                                time::TimeOfDay to) const;
 
     // View the last record in the log.
     TrainRecord viewLast();
 
 private:
-    void sort();
+    void trim();
 
-    std::vector<TrainRecord> m_history;
+    std::deque<TrainRecord> m_history;
+    std::vector<Sink> m_sinks;
+    std::size_t m_window{0};
 };
 
 }  // namespace pabo::train
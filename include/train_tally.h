@@ -0,0 +1,80 @@
+/**
+    @file include/train_tally.h
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief The definition of the TrainTally class.
+
+    Running aggregates over all trains of a dispatcher, kept up to date
+    as trains change so that summary queries need no scan. Trains are
+    identified by their position in the dispatcher.
+*/
+#ifndef INCLUDE_TRAIN_TALLY_H
+#define INCLUDE_TRAIN_TALLY_H
+
+#include "time_point.h"
+#include "train.h"
+#include <array>
+#include <atomic>
+#include <cstddef>  // size_t
+#include <mutex>
+#include <set>
+#include <vector>
+
+namespace pabo::train {
+
+class TrainTally {
+public:
+    using Duration = Train::Duration;
+
+    // The part of a train that the tally depends on.
+    struct Entry {
+        [[nodiscard]] static Entry of(const Train& t);
+
+        Train::State state;
+        int departureDelay;  // raw minutes
+        int arrivalDelay;  // raw minutes
+    };
+
+    TrainTally() = default;
+    explicit TrainTally(const std::vector<Train>& trains);
+
+    TrainTally(const TrainTally& other);
+    TrainTally& operator=(const TrainTally& other);
+
+    // Accounts for a change of the train at position idx. Safe to call
+    // concurrently for different trains.
+    void update(std::size_t idx, const Entry& before, const Entry& after);
+
+    [[nodiscard]] int trainCount() const noexcept;
+    [[nodiscard]] int count(Train::State s) const noexcept;
+    [[nodiscard]] Duration totalDepartureDelay() const noexcept;
+    [[nodiscard]] Duration totalArrivalDelay() const noexcept;
+
+    // Positions of the trains, in ascending order.
+    [[nodiscard]] std::vector<std::size_t> delayed() const;
+    [[nodiscard]] std::vector<std::size_t> nonDeparted() const;
+
+private:
+    static constexpr std::size_t stateCount{trainStates.size()};
+
+    void add(std::size_t idx, const Entry& e);
+
+    [[nodiscard]] static bool isDelayed(const Entry& e) noexcept;
+    [[nodiscard]] static bool hasDeparted(const Entry& e) noexcept;
+
+    int m_trainCount{0};
+    std::array<std::atomic<int>, stateCount> m_stateCounts{};
+    std::atomic<int> m_departureDelay{0};
+    std::atomic<int> m_arrivalDelay{0};
+
+    // Only touched when a train crosses a boundary, i.e. becomes
+    // delayed or departs, so the lock is rarely taken.
+    mutable std::mutex m_mutex;
+    std::set<std::size_t> m_delayed;
+    std::set<std::size_t> m_nonDeparted;
+};
+
+}  // namespace pabo::train
+
+#endif
@@ -9,12 +9,21 @@
 #define INCLUDE_TRAINS_APP_H
 
 #include "car_log.h"
+#include "departure_board.h"
+#include "event_metrics.h"
+#include "event_trace.h"
+#include "log_stream.h"
+#include "network.h"
 #include "printer.h"
 #include "simulator.h"
 #include "station.h"
+#include "thread_pool.h"
 #include "train.h"
 #include "train_dispatcher.h"
 #include "train_log.h"
+#include <cstddef>  // size_t
+#include <fstream>
+#include <memory>  // shared_ptr, unique_ptr
 #include <vector>
 
 namespace pabo::time {
@@ -37,15 +46,27 @@ public:
     void start();
     void reset();
 
+    // Runs the simulation for every configuration in SweepGrid.txt
+    // and writes the results to Sweep.csv.
+    void runParameterSweep();
+
+    // Runs every scenario in Scenarios.txt and writes the results to
+    // Scenarios.csv.
+    void runScenarioBatch();
+
     // Sim
     void printStartAndEndTimes();
+    void printExecutionMode();
     void printInterval();
     void printCurrentTime();
+    // Prints how many trains are in each state that is occupied.
+    void printProgress();
     void printNewTime();
 
     void changeInterval();
     void setStartTime();
     void setEndTime();
+    void setExecutionMode();
 
     void runNextInterval();
     void printHistory(time::TimeOfDay start, time::TimeOfDay end);
@@ -68,6 +89,11 @@ public:
     void showAllStationNames();
     void showStationByName();
     void showAllStations();
+    void showStationTimetable();
+    // Shows, or stops showing, the departure board of a station after
+    // each step of the simulation.
+    void toggleDepartureBoard();
+    void printDepartureBoards();
 
     // Vehicle
     void showVehicleById();
@@ -81,13 +107,67 @@ public:
     [[nodiscard]] LogLevel logLevel() const;
     void writeLogToFile();
 
+    // Writes Trainsim.log while the simulation runs, keeping only the
+    // latest records in memory.
+    void setLogStreaming();
+    void printLogStreaming();
+
+    // Writes a binary trace of the logged events to Trainsim.trace,
+    // see event_trace.h.
+    void toggleEventTrace();
+    void printEventTrace();
+
+    // Measures the processing of the events while the simulation runs,
+    // see event_metrics.h. The metrics are written to Metrics.txt when
+    // the simulation is complete.
+    void toggleEventMetrics();
+    void printEventMetricsSetting();
+    void showEventMetrics();
+
+    // Chooses how cars are allocated to trains, see allocation_policy.h.
+    void setAllocationPolicy();
+    void printAllocationPolicy();
+    // Moves empty cars to where they are needed, see repositioning.h.
+    void toggleRepositioning();
+    void printRepositioning();
+    // Limits the trains that run on a path at once, see track_occupancy.h.
+    void setTracksPerPath();
+    void printTracksPerPath();
+
 private:
+    void startLogStream();
+    void finishLogStream();
+    void startEventTrace();
+    void finishEventTrace();
+    void writeEventMetrics();
+#ifdef PABO_TRACING
+    // Writes the scopes traced since the reset to Trainsim.json, see
+    // scope_trace.h.
+    void writeScopeTrace();
+#endif
+
+    std::shared_ptr<const train::Network> m_network;
     TrainDispatcher m_dispatch;
     TrainLog m_log;
     CarLog m_carLog;
     Simulator m_sim{m_dispatch, m_log, m_carLog};
     Printer m_printer{m_dispatch};
     std::vector<train::Station> m_initialStationStates;
+    std::vector<train::DepartureBoard> m_boards;
+    ThreadPool m_pool;
+
+    // The number of records kept in memory while streaming, 0 if the
+    // log is written when the simulation is finished.
+    std::size_t m_streamWindow{0};
+    std::ofstream m_logFile;
+    std::unique_ptr<train::LogStream> m_logStream;
+
+    bool m_traceEnabled{false};
+    std::ofstream m_traceFile;
+    std::unique_ptr<train::TraceWriter> m_trace;
+
+    bool m_metricsEnabled{false};
+    std::unique_ptr<EventMetrics> m_metrics;
 };
 
 }  // namespace pabo::app
@@ -14,6 +14,8 @@
 #define INCLUDE_VEHICLE_TYPE_H
 
 #include "vehicle.h"
+#include <array>
+#include <cstddef>  // size_t
 #include <iosfwd>
 #include <string>
 
@@ -26,6 +28,18 @@ enum class Vehicle::Type { coach,
                            electricLocomotive,
                            dieselLocomotive };
 
+// Every type, in declaration order.
+inline constexpr std::array<Vehicle::Type, 6> vehicleTypes{
+        Vehicle::Type::coach, Vehicle::Type::sleepingCar,
+        Vehicle::Type::openFreightCar, Vehicle::Type::coveredFreightCar,
+        Vehicle::Type::electricLocomotive, Vehicle::Type::dieselLocomotive};
+
+// The position of a type in vehicleTypes.
+[[nodiscard]] constexpr std::size_t indexOf(Vehicle::Type t) noexcept
+{
+    return static_cast<std::size_t>(t);
+}
+
 std::string typeAsString(Vehicle::Type t);
 
 std::ostream& operator<<(std::ostream&, Vehicle::Type);
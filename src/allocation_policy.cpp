@@ -0,0 +1,187 @@
+/**
+    @file src/allocation_policy.cpp
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief Implementation of the car allocation policies.
+*/
+
+#include "allocation_policy.h"
+#include "station.h"
+#include "train_dispatcher.h"
+#include <memory>  // make_shared
+#include <stdexcept>  // invalid_argument
+
+namespace pabo::train {
+
+namespace {
+
+using CarView = AllocationPolicy::CarView;
+
+bool isLocomotive(const Vehicle::Type t)
+{
+    return t == Vehicle::Type::electricLocomotive
+           || t == Vehicle::Type::dieselLocomotive;
+}
+
+// True if the pool of the station holds every car the train misses.
+bool canBeCompleted(const Train& t, const Station& s)
+{
+    for (const auto type: vehicleTypes) {
+        if (t.missingCount(type) > s.carCount(type)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// The pool is sorted by id, so the first candidate that is strictly
+// better wins ties by lowest id.
+template<typename Better>
+CarView best(const std::vector<CarView>& candidates, Better better)
+{
+    auto res = CarView{nullptr};
+    for (const auto car: candidates) {
+        if (!res || better(car, res)) {
+            res = car;
+        }
+    }
+    return res;
+}
+
+}  // namespace
+
+bool AllocationPolicy::supportsRollback() const noexcept
+{
+    return true;
+}
+
+//
+// LowestIdPolicy
+//
+
+std::string LowestIdPolicy::name() const
+{
+    return "lowest-id";
+}
+
+CarView LowestIdPolicy::choose(const AllocationRequest& req) const
+{
+    return req.station.firstCar(req.type);
+}
+
+//
+// FastestFirstPolicy
+//
+
+std::string FastestFirstPolicy::name() const
+{
+    return "fastest";
+}
+
+CarView FastestFirstPolicy::choose(const AllocationRequest& req) const
+{
+    if (!isLocomotive(req.type)) {
+        return req.station.firstCar(req.type);
+    }
+    return best(req.station.availableCars(req.type),
+                [](CarView lhs, CarView rhs) {
+                    return rhs->maxSpeed() < lhs->maxSpeed();
+                });
+}
+
+//
+// LeastUsedPolicy
+//
+
+std::string LeastUsedPolicy::name() const
+{
+    return "least-used";
+}
+
+CarView LeastUsedPolicy::choose(const AllocationRequest& req) const
+{
+    const auto& disp = req.dispatcher;
+    return best(req.station.availableCars(req.type),
+                [&disp](CarView lhs, CarView rhs) {
+                    return disp.carUsage(lhs->id()) < disp.carUsage(rhs->id());
+                });
+}
+
+bool LeastUsedPolicy::supportsRollback() const noexcept
+{
+    // The usage counts of the dispatcher are not part of the saved
+    // state of a train or a station.
+    return false;
+}
+
+//
+// LookaheadPolicy
+//
+
+LookaheadPolicy::LookaheadPolicy(time::TimeOfDay horizon)
+    : m_horizon{horizon}
+{
+}
+
+std::string LookaheadPolicy::name() const
+{
+    return "lookahead";
+}
+
+CarView LookaheadPolicy::choose(const AllocationRequest& req) const
+{
+    const auto& [train, type, station, disp] = req;
+    const auto first = station.firstCar(type);
+    if (canBeCompleted(train, station)) {
+        return first;
+    }
+
+    // Any car this train takes now only waits with it, so keep enough
+    // for the trains that could leave on time with them. A train that
+    // is scheduled after the departure of this one can not have left
+    // yet, so only the origin station has touched it.
+    const auto earliest = train.departure();
+    const auto latest = earliest + m_horizon;
+    auto reserved = 0;
+    for (const auto& [scheduled, other]: disp.departuresFrom(station.id())) {
+        if (scheduled <= earliest) {
+            continue;
+        }
+        if (latest < scheduled) {
+            break;
+        }
+        if (other->missesCarOfType(type) && canBeCompleted(*other, station)) {
+            reserved += other->missingCount(type);
+        }
+    }
+    return station.carCount(type) > reserved ? first : nullptr;
+}
+
+//
+// Non-members
+//
+
+std::shared_ptr<const AllocationPolicy> makeAllocationPolicy(const std::string& name)
+{
+    if (name == "lowest-id") {
+        return std::make_shared<const LowestIdPolicy>();
+    }
+    if (name == "fastest") {
+        return std::make_shared<const FastestFirstPolicy>();
+    }
+    if (name == "least-used") {
+        return std::make_shared<const LeastUsedPolicy>();
+    }
+    if (name == "lookahead") {
+        return std::make_shared<const LookaheadPolicy>();
+    }
+    throw std::invalid_argument("No such allocation policy: " + name);
+}
+
+std::vector<std::string> allocationPolicyNames()
+{
+    return {"lowest-id", "fastest", "least-used", "lookahead"};
+}
+
+}  // namespace pabo::train
@@ -8,32 +8,78 @@
 
 #include "car_log.h"
 #include "vehicle.h"
+#include <algorithm>  // is_sorted, stable_sort
 #include <stdexcept>  // out_of_range
-#include <utility>  // move
+#include <string>
 
 namespace pabo::train {
 
-CarRecord::CarRecord(time::TimeOfDay tod, const int nbr, std::string stnName)
-    : time{tod}, trainNbr{nbr}, destination{std::move(stnName)}
+namespace {
+
+bool earlier(const CarRecord& lhs, const CarRecord& rhs)
+{
+    return lhs.rawTime < rhs.rawTime;
+}
+
+}  // namespace
+
+time::TimeOfDay CarRecord::time() const
 {
+    return time::TimeOfDay{static_cast<int>(rawTime)};
 }
 
-void CarLog::logArrival(time::TimeOfDay tod, const Train& t, const std::string& stnName)
+void CarLog::logArrival(time::TimeOfDay tod, const Train& t, const StationId station)
 {
+    const auto record = CarRecord{tod.rawTime(), t.number(), station};
     for (const auto& car: t.attachedCars()) {
-        auto& hist = m_history[car->id()];
-        hist.emplace_back(std::move(tod), t.number(), stnName);
+        historyOf(car->id()).push_back(record);
+    }
+}
+
+void CarLog::logTransfer(time::TimeOfDay tod, const std::vector<int>& ids, const StationId station)
+{
+    const auto record = CarRecord{tod.rawTime(), 0, station};
+    for (const auto id: ids) {
+        historyOf(id).push_back(record);
     }
 }
 
-std::vector<CarRecord> CarLog::viewRecordOf(const int carId)
+CarLog::History CarLog::viewRecordOf(const int carId) const
 {
-    const auto car = m_history.find(carId);
-    if (car == m_history.end()) {
+    if (carId < 0 || static_cast<std::size_t>(carId) >= m_history.size()
+        || m_history[carId].empty()) {
         throw std::out_of_range("No such car: " + std::to_string(carId));
     }
-    return car->second;
+    return m_history[carId].view();
 }
 
+void CarLog::merge(CarLog other)
+{
+    for (auto id = std::size_t{0}; id < other.m_history.size(); ++id) {
+        const auto& records = other.m_history[id];
+        if (records.empty()) {
+            continue;
+        }
+        auto& hist = historyOf(static_cast<int>(id));
+        for (const auto& rec: records) {
+            hist.push_back(rec);
+        }
+        if (!std::is_sorted(hist.begin(), hist.end(), earlier)) {
+            std::stable_sort(hist.begin(), hist.end(), earlier);
+        }
+    }
+}
+
+SmallVector<CarRecord, CarLog::inlineRecords>& CarLog::historyOf(const int carId)
+{
+    if (carId < 0) {
+        throw std::out_of_range("No such car: " + std::to_string(carId));
+    }
+    const auto idx = static_cast<std::size_t>(carId);
+    if (idx >= m_history.size()) {
+        m_history.resize(idx + 1);
+    }
+    return m_history[idx];
+}
 
 }  // namespace pabo::train
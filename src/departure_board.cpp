@@ -0,0 +1,89 @@
+/**
+    @file src/departure_board.cpp
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief Implementation of the DepartureBoard class.
+*/
+
+#include "departure_board.h"
+#include "train_dispatcher.h"
+#include <algorithm>  // remove_if
+#include <stdexcept>  // invalid_argument
+#include <vector>
+
+namespace pabo::train {
+
+DepartureBoard::DepartureBoard(const TrainDispatcher& disp, const StationId id,
+                               const std::size_t rows)
+    : m_disp{&disp}
+    , m_station{id}
+    , m_rows{rows}
+{
+    if (rows == 0) {
+        throw std::invalid_argument("A departure board must have at least one row!");
+    }
+    m_slots.reserve(rows);
+}
+
+std::size_t DepartureBoard::refresh()
+{
+    auto recomputed = std::size_t{0};
+    for (auto& s: m_slots) {
+        if (m_disp->changeCount(s.entry) != s.changes) {
+            s = makeSlot(s.entry);
+            ++recomputed;
+        }
+    }
+    const auto departed = [](const Slot& s) {
+        return s.row.state >= Train::State::running;
+    };
+    m_slots.erase(std::remove_if(m_slots.begin(), m_slots.end(), departed), m_slots.end());
+
+    // A train never comes back to the station, so the ones that had
+    // departed when they were passed are not looked at again.
+    const auto departures = m_disp->timetable().departuresFrom(m_station);
+    while (m_slots.size() < m_rows && m_next < departures.size()) {
+        const auto& entry = departures[m_next++];
+        if (!m_disp->viewTrain(entry).hasDeparted()) {
+            m_slots.push_back(makeSlot(entry));
+            ++recomputed;
+        }
+    }
+    return recomputed;
+}
+
+void DepartureBoard::reset() noexcept
+{
+    m_slots.clear();
+    m_next = 0;
+}
+
+StationId DepartureBoard::station() const noexcept
+{
+    return m_station;
+}
+
+std::vector<DepartureBoard::Row> DepartureBoard::rows() const
+{
+    auto res = std::vector<Row>{};
+    res.reserve(m_slots.size());
+    for (const auto& s: m_slots) {
+        res.push_back(s.row);
+    }
+    return res;
+}
+
+DepartureBoard::Slot DepartureBoard::makeSlot(const Timetable::Entry& entry) const
+{
+    // The count is read first, a change after it is found by the next
+    // refresh.
+    const auto changes = m_disp->changeCount(entry);
+    const auto& train = m_disp->viewTrain(entry);
+    const auto estimated = train.departure();
+    return {entry, changes,
+            {train.number(), m_disp->viewConnection(entry).destination(), entry.scheduled,
+             estimated, estimated - entry.scheduled, train.state()}};
+}
+
+}  // namespace pabo::train
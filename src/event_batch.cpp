@@ -0,0 +1,112 @@
+/**
+    @file src/event_batch.cpp
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief Implementation of the EventBatch class.
+*/
+
+#include "event_batch.h"
+#include "thread_pool.h"
+#include <stdexcept>  // logic_error
+#include <utility>  // move
+
+namespace pabo::app {
+
+thread_local EventBatch::Group* EventBatch::s_currentGroup{nullptr};
+
+EventBatch::EventBatch(const train::TrainDispatcher& disp, const EventHooks& hooks)
+    : m_hooks{hooks}, m_sites{disp}, m_groups(m_sites.stationCount())
+{
+}
+
+void EventBatch::add(EventPtr event)
+{
+    if (isEmpty()) {
+        m_time = event->time();
+    }
+    else if (event->time() != m_time) {
+        throw std::logic_error("Events in a batch must have the same time!");
+    }
+    const auto idx = m_sites.stationOf(*event);
+    auto& g = m_groups[idx];
+    if (g.queue.empty()) {
+        m_active.push_back(idx);
+    }
+    g.queue.emplace(std::move(event));
+}
+
+bool EventBatch::isEmpty() const noexcept
+{
+    return m_active.empty();
+}
+
+void EventBatch::schedule(EventPtr event)
+{
+    if (!s_currentGroup) {
+        throw std::logic_error("Event scheduled outside of a batch!");
+    }
+    // Only arrivals change station, and they are never at the time of
+    // the departure.
+    if (event->time() == m_time) {
+        s_currentGroup->queue.emplace(std::move(event));
+    }
+    else {
+        s_currentGroup->scheduled.emplace_back(std::move(event));
+    }
+}
+
+void EventBatch::run(ThreadPool& pool, train::TrainLog& log, train::CarLog& carLog)
+{
+    pool.parallelFor(m_active.size(), [this](std::size_t i) {
+        runGroup(m_groups[m_active[i]]);
+    });
+
+    // Merged into one log first, the batch is then an append to the log.
+    auto batchLog = train::TrainLog{};
+    for (const auto idx: m_active) {
+        auto& g = m_groups[idx];
+        batchLog.merge(std::move(g.log));
+        carLog.merge(std::move(g.carLog));
+        g.log = train::TrainLog{};
+        g.carLog = train::CarLog{};
+    }
+    log.merge(std::move(batchLog));
+    m_active.clear();
+}
+
+void EventBatch::runGroup(Group& g) const
+{
+    s_currentGroup = &g;
+    while (!g.queue.empty()) {
+        auto event = g.queue.top();
+        g.queue.pop();
+        m_hooks.process(*event, g.log, g.carLog);
+        if (event->isHighPriority()) {
+            ++g.highPriorityCount;
+        }
+    }
+    s_currentGroup = nullptr;
+}
+
+std::vector<EventBatch::EventPtr> EventBatch::takeScheduled()
+{
+    auto res = std::vector<EventPtr>{};
+    for (auto& g: m_groups) {
+        res.insert(res.end(), g.scheduled.begin(), g.scheduled.end());
+        g.scheduled.clear();
+    }
+    return res;
+}
+
+int EventBatch::takeHighPriorityCount()
+{
+    auto res = 0;
+    for (auto& g: m_groups) {
+        res += g.highPriorityCount;
+        g.highPriorityCount = 0;
+    }
+    return res;
+}
+
+}  // namespace pabo::app
@@ -0,0 +1,58 @@
+/**
+    @file src/event_hooks.cpp
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief Implementation of the EventHooks class.
+*/
+
+#include "event_hooks.h"
+#include <algorithm>  // remove
+#include <vector>
+
+namespace pabo::app {
+
+void EventHooks::add(EventObserver& observer)
+{
+    m_observers.push_back(&observer);
+}
+
+void EventHooks::remove(const EventObserver& observer) noexcept
+{
+    m_observers.erase(std::remove(m_observers.begin(), m_observers.end(), &observer),
+                      m_observers.end());
+}
+
+void EventHooks::clear() noexcept
+{
+    m_observers.clear();
+}
+
+bool EventHooks::isEmpty() const noexcept
+{
+    return m_observers.empty();
+}
+
+void EventHooks::notifyScheduled(const train::Event& event) const
+{
+    const auto notice = EventNotice{event.eventType(), event.time(), event.trainNbr()};
+    for (auto* o: m_observers) {
+        o->eventScheduled(notice);
+    }
+}
+
+void EventHooks::processObserved(train::Event& event, train::TrainLog& log,
+                                 train::CarLog& carLog) const
+{
+    // Read before the event is processed, which may change its time.
+    const auto notice = EventNotice{event.eventType(), event.time(), event.trainNbr()};
+    for (auto* o: m_observers) {
+        o->beforeEvent(notice);
+    }
+    event.processEvent(log, carLog);
+    for (auto* o: m_observers) {
+        o->afterEvent(notice);
+    }
+}
+
+}  // namespace pabo::app
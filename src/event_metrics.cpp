@@ -0,0 +1,211 @@
+/**
+    @file src/event_metrics.cpp
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief Implementation of the EventMetrics class.
+*/
+
+#include "event_metrics.h"
+#include <algorithm>  // max, partial_sort
+#include <chrono>
+#include <iomanip>  // setw
+#include <iostream>
+#include <stdexcept>  // invalid_argument, out_of_range
+#include <vector>
+
+namespace pabo::app {
+
+namespace {
+
+// When the thread started the event it is processing. A thread
+// processes one event at a time.
+thread_local std::chrono::steady_clock::time_point t_eventStart;
+
+constexpr std::array<train::EventType, 8> eventTypes{
+        train::EventType::start, train::EventType::assembly,
+        train::EventType::ready, train::EventType::departure,
+        train::EventType::arrival, train::EventType::disassembly,
+        train::EventType::transfer, train::EventType::transfer_arrival};
+
+const char* nameOf(const train::EventType type)
+{
+    switch (type) {
+    case train::EventType::assembly: return "assembly";
+    case train::EventType::ready: return "ready";
+    case train::EventType::departure: return "departure";
+    case train::EventType::arrival: return "arrival";
+    case train::EventType::disassembly: return "disassembly";
+    case train::EventType::start: return "start";
+    case train::EventType::transfer: return "transfer";
+    case train::EventType::transfer_arrival: return "transfer arrival";
+    }
+    return "unknown";
+}
+
+void raiseTo(std::atomic<std::uint64_t>& value, const std::uint64_t to) noexcept
+{
+    auto current = value.load(std::memory_order_relaxed);
+    while (current < to &&
+           !value.compare_exchange_weak(current, to, std::memory_order_relaxed)) {
+    }
+}
+
+}  // namespace
+
+EventMetrics::EventMetrics(const int highestTrainNbr)
+{
+    if (highestTrainNbr < 0) {
+        throw std::invalid_argument("A train number can not be negative!");
+    }
+    m_trainEvents = std::vector<std::atomic<std::uint32_t>>(
+            (static_cast<std::size_t>(highestTrainNbr) + 1) * typeCount);
+}
+
+void EventMetrics::eventScheduled(const EventNotice&)
+{
+    const auto scheduled = m_scheduled.fetch_add(1, std::memory_order_relaxed) + 1;
+    const auto processed = m_processed.load(std::memory_order_relaxed);
+    const auto hour = m_hour.load(std::memory_order_relaxed);
+    raiseTo(m_peakPending[static_cast<std::size_t>(hour)],
+            scheduled - std::min(scheduled, processed));
+}
+
+void EventMetrics::beforeEvent(const EventNotice& notice)
+{
+    m_hour.store(hourOf(notice), std::memory_order_relaxed);
+    t_eventStart = std::chrono::steady_clock::now();
+}
+
+void EventMetrics::afterEvent(const EventNotice& notice)
+{
+    const auto elapsed = std::chrono::steady_clock::now() - t_eventStart;
+    const auto type = indexOf(notice.type);
+    m_latency[type].record(static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+    m_processed.fetch_add(1, std::memory_order_relaxed);
+    m_eventsPerHour[hourOf(notice)].fetch_add(1, std::memory_order_relaxed);
+    const auto train = static_cast<std::size_t>(notice.trainNbr) * typeCount + type;
+    if (notice.trainNbr > 0 && train < m_trainEvents.size()) {
+        m_trainEvents[train].fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+const LatencyHistogram& EventMetrics::latency(const train::EventType type) const
+{
+    return m_latency[indexOf(type)];
+}
+
+std::uint64_t EventMetrics::eventCount() const noexcept
+{
+    return m_processed.load(std::memory_order_relaxed);
+}
+
+std::uint64_t EventMetrics::eventsInHour(const int hour) const
+{
+    return m_eventsPerHour.at(static_cast<std::size_t>(hour)).load(std::memory_order_relaxed);
+}
+
+std::uint64_t EventMetrics::peakPendingInHour(const int hour) const
+{
+    return m_peakPending.at(static_cast<std::size_t>(hour)).load(std::memory_order_relaxed);
+}
+
+std::uint64_t EventMetrics::retries(const int trainNbr) const
+{
+    if (trainNbr < 0 ||
+        static_cast<std::size_t>(trainNbr) * typeCount >= m_trainEvents.size()) {
+        throw std::out_of_range("No such train number!");
+    }
+    auto res = std::uint64_t{0};
+    const auto first = static_cast<std::size_t>(trainNbr) * typeCount;
+    for (auto i = first; i < first + typeCount; ++i) {
+        const auto n = m_trainEvents[i].load(std::memory_order_relaxed);
+        res += n > 1 ? n - 1 : 0;
+    }
+    return res;
+}
+
+std::vector<std::pair<int, std::uint64_t>> EventMetrics::mostRetried(const std::size_t count) const
+{
+    auto res = std::vector<std::pair<int, std::uint64_t>>{};
+    const auto trains = static_cast<int>(m_trainEvents.size() / typeCount);
+    for (auto nbr = 1; nbr < trains; ++nbr) {
+        if (const auto n = retries(nbr); n > 0) {
+            res.emplace_back(nbr, n);
+        }
+    }
+    const auto last = res.begin() + static_cast<std::ptrdiff_t>(std::min(count, res.size()));
+    std::partial_sort(res.begin(), last, res.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.second != rhs.second ? lhs.second > rhs.second : lhs.first < rhs.first;
+    });
+    res.erase(last, res.end());
+    return res;
+}
+
+std::size_t EventMetrics::indexOf(const train::EventType type)
+{
+    const auto res = static_cast<std::size_t>(type);
+    if (res >= typeCount) {
+        throw std::out_of_range("No such event type!");
+    }
+    return res;
+}
+
+int EventMetrics::hourOf(const EventNotice& notice) noexcept
+{
+    // The time of an event may wrap around midnight.
+    const auto hour = notice.time.rawTime() / 60 % hours;
+    return hour < 0 ? hour + hours : hour;
+}
+
+std::ostream& operator<<(std::ostream& os, const EventMetrics& metrics)
+{
+    const auto flags = os.flags();
+    const auto precision = os.precision();
+    os << "Events processed: " << metrics.eventCount() << "\n\n";
+
+    os << "Processing time per event type (microseconds):\n";
+    os << std::left << std::setw(18) << "type" << std::right << std::setw(8) << "count"
+       << std::setw(10) << "mean" << std::setw(10) << "p50" << std::setw(10) << "p99"
+       << std::setw(10) << "max" << std::setw(12) << "total" << '\n';
+    os << std::fixed << std::setprecision(1);
+    for (const auto type: eventTypes) {
+        const auto& h = metrics.latency(type);
+        if (h.count() == 0) {
+            continue;
+        }
+        const auto us = [](const auto ns) { return static_cast<double>(ns) / 1000.0; };
+        os << std::left << std::setw(18) << nameOf(type) << std::right << std::setw(8)
+           << h.count() << std::setw(10) << us(h.mean()) << std::setw(10)
+           << us(h.valueAt(0.5)) << std::setw(10) << us(h.valueAt(0.99)) << std::setw(10)
+           << us(h.max()) << std::setw(12) << us(h.total()) << '\n';
+    }
+    os << '\n';
+
+    os << "Per simulated hour (events, peak pending events):\n";
+    for (auto hour = 0; hour < 24; ++hour) {
+        const auto events = metrics.eventsInHour(hour);
+        const auto pending = metrics.peakPendingInHour(hour);
+        if (events == 0 && pending == 0) {
+            continue;
+        }
+        os << std::setfill('0') << std::setw(2) << hour << ":00" << std::setfill(' ')
+           << std::setw(8) << events << std::setw(8) << pending << '\n';
+    }
+    os << '\n';
+
+    const auto retried = metrics.mostRetried(10);
+    os << "Trains with the most retries:\n";
+    if (retried.empty()) {
+        os << "[none]\n";
+    }
+    for (const auto& [nbr, n]: retried) {
+        os << '[' << nbr << "] " << n << '\n';
+    }
+    os.flags(flags);
+    os.precision(precision);
+    return os;
+}
+
+}  // namespace pabo::app
@@ -0,0 +1,58 @@
+/**
+    @file src/event_sites.cpp
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief Implementation of the EventSites class.
+*/
+
+#include "event.h"
+#include "event_sites.h"
+#include "train_dispatcher.h"
+#include <algorithm>  // find
+#include <iterator>  // begin, end, distance
+#include <stdexcept>  // logic_error, out_of_range
+#include <string>
+
+namespace pabo::app {
+
+EventSites::EventSites(const train::TrainDispatcher& disp)
+    : m_stations{disp.stationIds()}
+{
+    const auto indexOf = [this](const train::StationId id) {
+        using std::begin;
+        using std::end;
+        const auto station = std::find(begin(m_stations), end(m_stations), id);
+        if (station == end(m_stations)) {
+            throw std::out_of_range("Station does not exist: " +
+                                    std::string{train::stationName(id)});
+        }
+        return static_cast<std::size_t>(std::distance(begin(m_stations), station));
+    };
+    for (const auto nbr: disp.trainNumbers()) {
+        m_sites[nbr] = {indexOf(disp.origin(nbr)), indexOf(disp.destination(nbr))};
+    }
+}
+
+std::size_t EventSites::stationCount() const noexcept
+{
+    return m_stations.size();
+}
+
+train::StationId EventSites::station(std::size_t idx) const
+{
+    return m_stations.at(idx);
+}
+
+std::size_t EventSites::stationOf(const train::Event& event) const
+{
+    const auto site = event.site();
+    if (site == train::Site::none) {
+        throw std::logic_error("Event of type " + event.type() +
+                               " does not belong to a station!");
+    }
+    const auto& [origin, destination] = m_sites.at(event.trainNbr());
+    return (site == train::Site::origin) ? origin : destination;
+}
+
+}  // namespace pabo::app
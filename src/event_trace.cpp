@@ -0,0 +1,161 @@
+/**
+    @file src/event_trace.cpp
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief Implementation of the TraceWriter class.
+*/
+
+#include "event_trace.h"
+#include "event_type.h"
+#include "station_id.h"
+#include "train_log.h"
+#include <algorithm>  // fill
+#include <cstring>  // memcpy
+#include <iterator>  // begin, end
+#include <limits>
+#include <ostream>
+#include <stdexcept>  // invalid_argument, out_of_range
+#include <utility>  // move
+
+namespace pabo::train {
+
+namespace {
+
+template<typename T>
+void append(std::vector<char>& out, const T& value)
+{
+    const auto* bytes = reinterpret_cast<const char*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+// Copies a column, padded with zeroes to the rows of a chunk.
+template<typename T>
+char* copyColumn(char* out, const std::vector<T>& column, std::size_t rows)
+{
+    std::memcpy(out, column.data(), column.size() * sizeof(T));
+    std::fill(out + column.size() * sizeof(T), out + rows * sizeof(T), '\0');
+    return out + rows * sizeof(T);
+}
+
+// Events up to the departure take place at the origin.
+bool isAtOrigin(EventType type)
+{
+    return type == EventType::assembly || type == EventType::ready ||
+           type == EventType::departure;
+}
+
+}  // namespace
+
+TraceWriter::TraceWriter(std::ostream& os, std::vector<std::string> stationNames,
+                         std::size_t chunkRows)
+    : m_os{os}, m_stationNames{std::move(stationNames)}, m_chunkRows{chunkRows}
+{
+    if (m_chunkRows == 0 || m_chunkRows % 8 != 0) {
+        throw std::invalid_argument("Rows per chunk must be a positive multiple of 8!");
+    }
+    if (m_stationNames.size() > std::numeric_limits<std::uint16_t>::max()) {
+        throw std::invalid_argument("Too many stations for a trace!");
+    }
+    for (auto i = std::size_t{0}; i < m_stationNames.size(); ++i) {
+        m_stationIds[internStation(m_stationNames[i])] = static_cast<std::uint16_t>(i);
+    }
+    m_time.reserve(m_chunkRows);
+    m_trainNbr.reserve(m_chunkRows);
+    m_departureDelay.reserve(m_chunkRows);
+    m_arrivalDelay.reserve(m_chunkRows);
+    m_speed.reserve(m_chunkRows);
+    m_station.reserve(m_chunkRows);
+    m_type.reserve(m_chunkRows);
+    m_state.reserve(m_chunkRows);
+    writeHeader();
+}
+
+TraceWriter::~TraceWriter()
+{
+    try {
+        finish();
+    }
+    catch (...) {
+        // Nothing sensible to do with a failing stream here.
+    }
+}
+
+void TraceWriter::writeHeader()
+{
+    auto header = std::vector<char>(std::begin(trace::magic), std::end(trace::magic));
+    append(header, trace::version);
+    append(header, static_cast<std::uint32_t>(m_chunkRows));
+    append(header, static_cast<std::uint32_t>(m_stationNames.size()));
+    for (const auto& name: m_stationNames) {
+        append(header, static_cast<std::uint16_t>(name.size()));
+        header.insert(header.end(), name.begin(), name.end());
+    }
+    header.resize((header.size() + 7) / 8 * 8, '\0');
+    m_os.write(header.data(), static_cast<std::streamsize>(header.size()));
+}
+
+void TraceWriter::write(const TrainRecord& tr)
+{
+    const auto& train = tr.train;
+    const auto station = isAtOrigin(tr.type) ? train.origin : train.destination;
+    const auto id = m_stationIds.find(station);
+    if (id == m_stationIds.end()) {
+        throw std::out_of_range("Station does not exist: " +
+                                std::string{stationName(station)});
+    }
+
+    m_time.push_back(tr.time.rawTime());
+    m_trainNbr.push_back(train.number);
+    m_departureDelay.push_back(train.departureDelay.rawTime());
+    m_arrivalDelay.push_back(train.arrivalDelay.rawTime());
+    m_speed.push_back(static_cast<float>(train.speed.value));
+    m_station.push_back(id->second);
+    m_type.push_back(static_cast<std::uint8_t>(tr.type));
+    m_state.push_back(static_cast<std::uint8_t>(train.state));
+
+    if (m_time.size() == m_chunkRows) {
+        writeChunk();
+    }
+}
+
+void TraceWriter::writeChunk()
+{
+    m_chunk.resize(trace::chunkSize(m_chunkRows));
+    auto* out = m_chunk.data();
+    const auto count = static_cast<std::uint32_t>(m_time.size());
+    const auto zero = std::uint32_t{0};
+    std::memcpy(out, &count, sizeof(count));
+    std::memcpy(out + 4, &zero, sizeof(zero));
+    out += 8;
+    out = copyColumn(out, m_time, m_chunkRows);
+    out = copyColumn(out, m_trainNbr, m_chunkRows);
+    out = copyColumn(out, m_departureDelay, m_chunkRows);
+    out = copyColumn(out, m_arrivalDelay, m_chunkRows);
+    out = copyColumn(out, m_speed, m_chunkRows);
+    out = copyColumn(out, m_station, m_chunkRows);
+    out = copyColumn(out, m_type, m_chunkRows);
+    copyColumn(out, m_state, m_chunkRows);
+    m_os.write(m_chunk.data(), static_cast<std::streamsize>(m_chunk.size()));
+
+    m_time.clear();
+    m_trainNbr.clear();
+    m_departureDelay.clear();
+    m_arrivalDelay.clear();
+    m_speed.clear();
+    m_station.clear();
+    m_type.clear();
+    m_state.clear();
+}
+
+void TraceWriter::finish()
+{
+    if (m_finished) { return; }
+    m_finished = true;
+    if (!m_time.empty()) {
+        writeChunk();
+    }
+    m_os.flush();
+}
+
+}  // namespace pabo::train
@@ -8,13 +8,15 @@
 #include "arrival_event.h"
 #include "car_log.h"
 #include "disassembly_event.h"
-#include "sim_constants.h"
+#include "scope_trace.h"
+#include "sim_config.h"
 #include "simulator.h"
 #include "time_point.h"
 #include "train.h"
 #include "train_dispatcher.h"
 #include "train_log.h"
 #include <memory>  // make_unique
+#include <optional>
 #include <string>
 #include <utility>  // move
 
@@ -24,17 +26,23 @@ using app::Simulator;
 using time::TimeOfDay;
 
 ArrivalEvent::ArrivalEvent(Simulator& sim, TrainDispatcher& disp,
-                           int trainNbr, TimeOfDay time)
+                           int trainNbr, TimeOfDay time,
+                           std::optional<TimeOfDay> waitingSince)
     : Event{time}
     , m_sim{sim}
     , m_disp{disp}
     , m_trainNbr{trainNbr}
     , m_currentTrain{&m_disp.viewTrain(m_trainNbr)}
+    , m_waitingSince{waitingSince}
 {
 }
 
 void ArrivalEvent::processEvent_(TrainLog& logger, CarLog& carLog)
 {
+    PABO_TRACE_SCOPE("ArrivalEvent::processEvent_");
+    if (waitForPlatform(logger)) {
+        return;
+    }
     updateStateOfTrain();
     calculateDisassemblyTime();
     if (m_time >= m_sim.startTime()) {
@@ -44,6 +52,22 @@ void ArrivalEvent::processEvent_(TrainLog& logger, CarLog& carLog)
     scheduleDisassemblyEvent();
 }
 
+bool ArrivalEvent::waitForPlatform(TrainLog& logger)
+{
+    if (m_waitingSince) {
+        m_disp.delayArrival(m_trainNbr, m_time - *m_waitingSince);
+        return false;
+    }
+    if (m_disp.takePlatform(m_trainNbr, m_disp.destination(m_trainNbr), m_time)) {
+        return false;
+    }
+    if (m_time >= m_sim.startTime()) {
+        logger.log({m_time, EventType::arrival, {*m_currentTrain, m_disp},
+                    "is waiting for a free platform"});
+    }
+    return true;
+}
+
 void ArrivalEvent::updateStateOfTrain()
 {
     m_disp.setStateOfTrain(m_trainNbr, Train::State::arrived);
@@ -52,12 +76,12 @@ void ArrivalEvent::updateStateOfTrain()
 
 void ArrivalEvent::calculateDisassemblyTime()
 {
-    m_disassemblyTime = m_time + constants::timeBetweenArrivalAndDisassembly;
+    m_disassemblyTime = m_time + m_sim.config().timeBetweenArrivalAndDisassembly;
 }
 
 void ArrivalEvent::logArrivingTrain(TrainLog& logger)
 {
-    logger.log({m_time, *m_currentTrain,
+    logger.log({m_time, EventType::arrival, {*m_currentTrain, m_disp},
                 "Has Arrived at the platform disassembly at " +
                         m_disassemblyTime.asString()});
 }
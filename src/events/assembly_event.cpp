@@ -9,8 +9,10 @@
 #include "assembly_event.h"
 #include "event.h"
 #include "ready_event.h"
-#include "sim_constants.h"
+#include "scope_trace.h"
+#include "sim_config.h"
 #include "simulator.h"
+#include "station.h"
 #include "time_point.h"
 #include "train.h"
 #include "train_dispatcher.h"
@@ -28,18 +30,57 @@ using time::TimeOfDay;
 
 
 AssemblyEvent::AssemblyEvent(Simulator& sim, TrainDispatcher& disp,
-                             int trainNbr, TimeOfDay time)
+                             int trainNbr, TimeOfDay time, int skippedAttempts)
     : Event{time}
     , m_sim{sim}
     , m_disp{disp}
     , m_trainNbr{trainNbr}
+    , m_skippedAttempts{skippedAttempts}
     , m_currentTrain{&m_disp.viewTrain(m_trainNbr)}
 {
 }
 
+void AssemblyEvent::wakeWaitingTrains(Simulator& sim, TrainDispatcher& disp,
+                                      const StationId station, const Event& cause)
+{
+    // A waiting train is woken at the first of its skipped attempts
+    // that comes after the cause, the attempts before it would have
+    // failed.
+    const auto retry = sim.config().timeBetweenAssemblyAttempts.rawTime();
+    const auto time = cause.time();
+    const auto firstAttemptAfter = [&cause, time, retry](const Station::Waiter& w) {
+        auto skipped = 0;
+        if (w.nextAttempt <= time) {
+            skipped = (time.rawTime() - w.nextAttempt.rawTime()) / retry;
+            const auto attempt = w.nextAttempt.rawTime() + skipped * retry;
+            if (attempt < time.rawTime() || w.trainNbr < cause.trainNbr()) {
+                ++skipped;
+            }
+        }
+        return skipped;
+    };
+    const auto timeOf = [retry](const Station::Waiter& w, int skipped) {
+        return TimeOfDay{w.nextAttempt.rawTime() + skipped * retry};
+    };
+
+    const auto woken = disp.wakeWaitingTrains(
+            station, [&](const Station::Waiter& w) {
+                return timeOf(w, firstAttemptAfter(w)) < sim.endTime();
+            });
+    for (const auto& w: woken) {
+        const auto skipped = firstAttemptAfter(w);
+        sim.scheduleEvent(std::make_shared<AssemblyEvent>(
+                sim, disp, w.trainNbr, timeOf(w, skipped), skipped));
+    }
+}
+
 void AssemblyEvent::processEvent_(TrainLog& log, CarLog&)
 {
-    m_disp.tryAssembleTrain(m_trainNbr);
+    PABO_TRACE_SCOPE("AssemblyEvent::processEvent_");
+    if (m_skippedAttempts > 0) {
+        delayDeparture(m_skippedAttempts);
+    }
+    m_disp.tryAssembleTrain(m_trainNbr, *m_sim.config().allocation);
     if (m_disp.trainIsAssembled(m_trainNbr)) {
         processAssembledTrain(log);
     }
@@ -62,12 +103,12 @@ void AssemblyEvent::processAssembledTrain(TrainLog& log)
 void AssemblyEvent::calculateTimeForReadyEvent()
 {
     m_timeOfNext = m_disp.estimatedTimeOfDeparture(m_trainNbr) -
-                   constants::timeBetweenAssembledAndReady;
+                   m_sim.config().timeBetweenAssembledAndReady;
 }
 
 void AssemblyEvent::logAssembledTrain(TrainLog& log)
 {
-    log.log({m_time, *m_currentTrain,
+    log.log({m_time, EventType::assembly, {*m_currentTrain, m_disp},
              "is now assembled, arriving at the platform at " +
                      m_timeOfNext.asString()});
 }
@@ -85,27 +126,39 @@ void AssemblyEvent::processIncompleteTrain(TrainLog& log)
         m_disp.setStateOfTrain(m_trainNbr, Train::State::incomplete);
     }
     calculateNextAttempt();
-    delayDeparture();
+    delayDeparture(1);
+    const auto waiting = waitForCars();
     if (m_time >= m_sim.startTime()) {
-        logIncompleteTrain(log);
+        logIncompleteTrain(log, waiting);
+    }
+    if (!waiting) {
+        scheduleNewAssemblyEvent();
     }
-    scheduleNewAssemblyEvent();
 }
 
 void AssemblyEvent::calculateNextAttempt()
 {
-    m_timeOfNext = m_time + constants::timeBetweenAssemblyAttempts;
+    m_timeOfNext = m_time + m_sim.config().timeBetweenAssemblyAttempts;
+}
+
+void AssemblyEvent::delayDeparture(const int attempts)
+{
+    const auto retry = m_sim.config().timeBetweenAssemblyAttempts;
+    m_disp.delayDeparture(m_trainNbr, TimeOfDay{retry.rawTime() * attempts});
 }
 
-void AssemblyEvent::delayDeparture()
+bool AssemblyEvent::waitForCars()
 {
-    m_disp.delayDeparture(m_trainNbr, constants::timeBetweenAssemblyAttempts);
+    // An attempt that would not be run is not waited for either.
+    return m_timeOfNext < m_sim.endTime() &&
+           m_disp.waitForCars(m_trainNbr, m_timeOfNext);
 }
 
-void AssemblyEvent::logIncompleteTrain(TrainLog& log)
+void AssemblyEvent::logIncompleteTrain(TrainLog& log, const bool waiting)
 {
-    log.log({m_time, *m_currentTrain,
-             "is now incomplete, next try " + m_timeOfNext.asString()});
+    log.log({m_time, EventType::assembly, {*m_currentTrain, m_disp},
+             waiting ? "is now incomplete, waiting for cars"
+                     : "is now incomplete, next try " + m_timeOfNext.asString()});
 }
 
 void AssemblyEvent::scheduleNewAssemblyEvent()
@@ -9,13 +9,15 @@
 #include "capacity.h"
 #include "departure_event.h"
 #include "event.h"
+#include "ready_event.h"
+#include "scope_trace.h"
 #include "simulator.h"
 #include "time_point.h"
 #include "train.h"
 #include "train_dispatcher.h"
 #include "train_log.h"
 #include <iomanip>
-#include <memory>  // make_unique
+#include <memory>  // make_shared
 #include <sstream>
 #include <string>
 #include <utility>  // move
@@ -39,16 +41,39 @@ DepartureEvent::DepartureEvent(Simulator& sim, TrainDispatcher& disp,
 
 void DepartureEvent::processEvent_(TrainLog& logger, CarLog&)
 {
+    PABO_TRACE_SCOPE("DepartureEvent::processEvent_");
+    if (waitForTrack(logger)) {
+        return;
+    }
     updateTrainState();
+    ReadyEvent::leavePlatform(m_sim, m_disp, m_disp.origin(m_trainNbr), *this);
     if (m_time >= m_sim.startTime()) {
         logDepartedTrain(logger);
     }
     scheduleArrivalEvent();
 }
 
+bool DepartureEvent::waitForTrack(TrainLog& logger)
+{
+    const auto wait = m_disp.earliestFreeDeparture(m_trainNbr).rawTime() -
+                      m_disp.estimatedTimeOfDeparture(m_trainNbr).rawTime();
+    if (wait <= 0) {
+        return false;
+    }
+    m_disp.delayDeparture(m_trainNbr, TimeOfDay{wait});
+    const auto next = m_time + TimeOfDay{wait};
+    if (m_time >= m_sim.startTime()) {
+        logger.log({m_time, EventType::departure, {*m_currentTrain, m_disp},
+                    "is waiting for a free track, departing at " + next.asString()});
+    }
+    m_sim.scheduleEvent(std::make_shared<DepartureEvent>(m_sim, m_disp, m_trainNbr, next));
+    return true;
+}
+
 void DepartureEvent::updateTrainState()
 {
     m_disp.setOptimalSpeedOfTrain(m_trainNbr);
+    m_disp.reserveTracks(m_trainNbr);
     m_disp.setDepartureDelay(m_trainNbr);
     m_disp.setStateOfTrain(m_trainNbr, Train::State::running);
 }
@@ -56,7 +81,7 @@ void DepartureEvent::updateTrainState()
 void DepartureEvent::logDepartedTrain(TrainLog& logger)
 {
     prepareLogMessage();
-    logger.log({m_time, *m_currentTrain, m_logMsg});
+    logger.log({m_time, EventType::departure, {*m_currentTrain, m_disp}, m_logMsg});
 }
 
 void DepartureEvent::prepareLogMessage()
@@ -6,7 +6,10 @@
     @brief The implementation of the disassembly event.
 */
 
+#include "assembly_event.h"
 #include "disassembly_event.h"
+#include "ready_event.h"
+#include "scope_trace.h"
 #include "simulator.h"
 #include "time_point.h"
 #include "train.h"
@@ -33,7 +36,10 @@ DisassemblyEvent::DisassemblyEvent(Simulator& sim, TrainDispatcher& disp,
 
 void DisassemblyEvent::processEvent_(TrainLog& logger, CarLog&)
 {
+    PABO_TRACE_SCOPE("DisassemblyEvent::processEvent_");
     updateStateOfTrain();
+    AssemblyEvent::wakeWaitingTrains(m_sim, m_disp, m_disp.destination(m_trainNbr), *this);
+    ReadyEvent::leavePlatform(m_sim, m_disp, m_disp.destination(m_trainNbr), *this);
     if (m_time >= m_sim.startTime()) {
         logDisassembledTrain(logger);
     }
@@ -48,7 +54,7 @@ void DisassemblyEvent::updateStateOfTrain()
 
 void DisassemblyEvent::logDisassembledTrain(TrainLog& logger)
 {
-    logger.log({m_time, *m_currentTrain, "is now disassembled."});
+    logger.log({m_time, EventType::disassembly, {*m_currentTrain, m_disp}, "is now disassembled."});
 }
 
 }  // namespace pabo::train
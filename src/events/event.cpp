@@ -20,15 +20,33 @@ std::string Event::type() const
     return type_();
 }
 
+EventType Event::eventType() const
+{
+    return eventType_();
+}
+
 bool Event::isHighPriority() const
 {
     return isHighPriority_();
 }
 
+int Event::trainNbr() const
+{
+    return trainNbr_();
+}
+
+Site Event::site() const
+{
+    return site_();
+}
+
 bool EventComparison::operator()(const std::shared_ptr<Event>& lhs,
                                  const std::shared_ptr<Event>& rhs)
 {
-    return lhs->time() > rhs->time();
+    if (lhs->time() != rhs->time()) {
+        return lhs->time() > rhs->time();
+    }
+    return lhs->trainNbr() > rhs->trainNbr();
 }
 
 }  // namespace pabo::train
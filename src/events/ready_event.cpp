@@ -6,16 +6,19 @@
     @brief The implementation of the ready event.
 */
 
+#include "arrival_event.h"
 #include "departure_event.h"
 #include "event.h"
 #include "ready_event.h"
-#include "sim_constants.h"
+#include "scope_trace.h"
+#include "sim_config.h"
 #include "simulator.h"
 #include "time_point.h"
 #include "train.h"
 #include "train_dispatcher.h"
 #include "train_log.h"
 #include <memory>  // make_unique
+#include <optional>
 #include <string>
 #include <utility>  // move
 
@@ -27,17 +30,50 @@ using app::Simulator;
 using time::TimeOfDay;
 
 ReadyEvent::ReadyEvent(Simulator& sim, TrainDispatcher& disp,
-                       int trainNbr, TimeOfDay time)
+                       int trainNbr, TimeOfDay time,
+                       std::optional<TimeOfDay> waitingSince)
     : Event{time}
     , m_sim{sim}
     , m_disp{disp}
     , m_trainNbr{trainNbr}
     , m_currentTrain{&m_disp.viewTrain(m_trainNbr)}
+    , m_waitingSince{waitingSince}
 {
 }
 
+void ReadyEvent::leavePlatform(Simulator& sim, TrainDispatcher& disp,
+                               const StationId station, const Event& cause)
+{
+    // The waiting train is woken at the first tick that comes after
+    // the cause, its own event applies the delay.
+    const auto wakeTime = [&cause](const PlatformOccupancy::Waiter& w) {
+        return w.trainNbr > cause.trainNbr() ? cause.time() : cause.time() + TimeOfDay{1};
+    };
+    const auto woken = disp.leavePlatform(
+            station, cause.time(), [&](const PlatformOccupancy::Waiter& w) {
+                return wakeTime(w) < sim.endTime();
+            });
+    if (!woken) {
+        return;
+    }
+    const auto time = wakeTime(*woken);
+    const auto since = TimeOfDay{woken->since};
+    if (disp.viewTrain(woken->trainNbr).hasDeparted()) {
+        sim.scheduleEvent(std::make_shared<ArrivalEvent>(
+                sim, disp, woken->trainNbr, time, since));
+    }
+    else {
+        sim.scheduleEvent(std::make_shared<ReadyEvent>(
+                sim, disp, woken->trainNbr, time, since));
+    }
+}
+
 void ReadyEvent::processEvent_(TrainLog& logger, CarLog&)
 {
+    PABO_TRACE_SCOPE("ReadyEvent::processEvent_");
+    if (waitForPlatform(logger)) {
+        return;
+    }
     updateStateOfTrain();
     calculateTimeOfDeparture();
     if (m_time >= m_sim.startTime()) {
@@ -46,6 +82,22 @@ void ReadyEvent::processEvent_(TrainLog& logger, CarLog&)
     scheduleDepartureEvent();
 }
 
+bool ReadyEvent::waitForPlatform(TrainLog& logger)
+{
+    if (m_waitingSince) {
+        m_disp.delayDeparture(m_trainNbr, m_time - *m_waitingSince);
+        return false;
+    }
+    if (m_disp.takePlatform(m_trainNbr, m_disp.origin(m_trainNbr), m_time)) {
+        return false;
+    }
+    if (m_time >= m_sim.startTime()) {
+        logger.log({m_time, EventType::ready, {*m_currentTrain, m_disp},
+                    "is waiting for a free platform"});
+    }
+    return true;
+}
+
 void ReadyEvent::updateStateOfTrain()
 {
     m_disp.setStateOfTrain(m_trainNbr, Train::State::ready);
@@ -53,12 +105,12 @@ void ReadyEvent::updateStateOfTrain()
 
 void ReadyEvent::calculateTimeOfDeparture()
 {
-    m_timeOfDeparture = m_time + constants::timeBetweenReadyAndDeparture;
+    m_timeOfDeparture = m_time + m_sim.config().timeBetweenReadyAndDeparture;
 }
 
 void ReadyEvent::logReadyTrain(TrainLog& logger)
 {
-    logger.log({m_time, *m_currentTrain, "is now at the platform, departing at " + m_timeOfDeparture.asString()});
+    logger.log({m_time, EventType::ready, {*m_currentTrain, m_disp}, "is now at the platform, departing at " + m_timeOfDeparture.asString()});
 }
 
 void ReadyEvent::scheduleDepartureEvent()
@@ -10,12 +10,15 @@
 
 #include "assembly_event.h"
 #include "event.h"
-#include "sim_constants.h"
+#include "repositioning.h"
+#include "scope_trace.h"
+#include "sim_config.h"
 #include "simulator.h"
 #include "start_event.h"
 #include "time_point.h"
 #include "train_dispatcher.h"
-#include <memory>  // unique_ptr, make_unique
+#include "transfer_event.h"
+#include <memory>  // make_shared, make_unique, unique_ptr
 #include <utility>  // move
 #include <vector>
 
@@ -34,16 +37,21 @@ StartEvent::StartEvent(Simulator& sim, TrainDispatcher& disp)
 
 void StartEvent::processEvent_(TrainLog&, CarLog&)
 {
+    PABO_TRACE_SCOPE("StartEvent::processEvent_");
+    m_disp.setTracksPerPath(m_sim.config().tracksPerPath);
     for (const auto& trainNbr: m_disp.trainNumbers()) {
         const auto time = calculateAssemblyTime(trainNbr);
         scheduleAssemblyEvent(trainNbr, time);
     }
+    if (m_sim.config().repositioning) {
+        scheduleTransferEvents();
+    }
 }
 
 time::TimeOfDay StartEvent::calculateAssemblyTime(const int trainNbr) const
 {
     return m_disp.scheduledTimeOfDeparture(trainNbr) -
-           constants::timeBetweenDepartureAndAssembly;
+           m_sim.config().timeBetweenDepartureAndAssembly;
 }
 
 void StartEvent::scheduleAssemblyEvent(int trainNbr, time::TimeOfDay time)
@@ -52,6 +60,13 @@ void StartEvent::scheduleAssemblyEvent(int trainNbr, time::TimeOfDay time)
     m_sim.scheduleEvent(std::move(e));
 }
 
+void StartEvent::scheduleTransferEvents()
+{
+    for (auto& transfer: planRepositioning(m_disp, m_sim.config())) {
+        m_sim.scheduleEvent(std::make_shared<TransferEvent>(m_sim, m_disp, std::move(transfer)));
+    }
+}
+
 }  // namespace pabo::train
 
 #endif
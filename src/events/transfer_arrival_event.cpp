@@ -0,0 +1,46 @@
+/**
+    @file src/transfer_arrival_event.cpp
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief The implementation of the transfer arrival event.
+*/
+
+#include "assembly_event.h"
+#include "car_log.h"
+#include "scope_trace.h"
+#include "simulator.h"
+#include "time_point.h"
+#include "train_dispatcher.h"
+#include "transfer_arrival_event.h"
+#include "station_id.h"
+#include <utility>  // move
+#include <vector>
+
+namespace pabo::train {
+
+using app::Simulator;
+using time::TimeOfDay;
+
+TransferArrivalEvent::TransferArrivalEvent(Simulator& sim, TrainDispatcher& disp,
+                                           std::vector<int> carIds,
+                                           const StationId destination, TimeOfDay time)
+    : Event{time}
+    , m_sim{sim}
+    , m_disp{disp}
+    , m_carIds{std::move(carIds)}
+    , m_destination{destination}
+{
+}
+
+void TransferArrivalEvent::processEvent_(TrainLog&, CarLog& carLog)
+{
+    PABO_TRACE_SCOPE("TransferArrivalEvent::processEvent_");
+    m_disp.receiveCars(m_carIds);
+    if (m_time >= m_sim.startTime()) {
+        carLog.logTransfer(m_time, m_carIds, m_destination);
+    }
+    AssemblyEvent::wakeWaitingTrains(m_sim, m_disp, m_destination, *this);
+}
+
+}  // namespace pabo::train
@@ -0,0 +1,44 @@
+/**
+    @file src/transfer_event.cpp
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief The implementation of the transfer event.
+*/
+
+#include "repositioning.h"
+#include "scope_trace.h"
+#include "simulator.h"
+#include "train_dispatcher.h"
+#include "transfer_arrival_event.h"
+#include "transfer_event.h"
+#include <memory>  // make_shared
+#include <utility>  // move
+
+namespace pabo::train {
+
+using app::Simulator;
+
+TransferEvent::TransferEvent(Simulator& sim, TrainDispatcher& disp, Transfer transfer)
+    : Event{transfer.departure}
+    , m_sim{sim}
+    , m_disp{disp}
+    , m_transfer{std::move(transfer)}
+{
+}
+
+void TransferEvent::processEvent_(TrainLog&, CarLog&)
+{
+    PABO_TRACE_SCOPE("TransferEvent::processEvent_");
+    // Fewer cars than planned are sent if the trains have been late to
+    // return them.
+    auto ids = m_disp.sendCars(m_transfer.from, m_transfer.to,
+                               m_transfer.type, m_transfer.count);
+    if (ids.empty()) {
+        return;
+    }
+    m_sim.scheduleEvent(std::make_shared<TransferArrivalEvent>(
+            m_sim, m_disp, std::move(ids), m_transfer.to, m_transfer.arrival));
+}
+
+}  // namespace pabo::train
@@ -0,0 +1,99 @@
+/**
+    @file src/latency_histogram.cpp
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief Implementation of the LatencyHistogram class.
+*/
+
+#include "latency_histogram.h"
+#include <algorithm>  // min
+#include <cmath>  // ceil
+#include <stdexcept>  // out_of_range
+
+namespace pabo {
+
+void LatencyHistogram::record(const std::uint64_t nanoseconds) noexcept
+{
+    m_buckets[bucketOf(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    m_total.fetch_add(nanoseconds, std::memory_order_relaxed);
+    auto max = m_max.load(std::memory_order_relaxed);
+    while (max < nanoseconds &&
+           !m_max.compare_exchange_weak(max, nanoseconds, std::memory_order_relaxed)) {
+    }
+}
+
+std::uint64_t LatencyHistogram::count() const noexcept
+{
+    return m_count.load(std::memory_order_relaxed);
+}
+
+std::uint64_t LatencyHistogram::total() const noexcept
+{
+    return m_total.load(std::memory_order_relaxed);
+}
+
+std::uint64_t LatencyHistogram::max() const noexcept
+{
+    return m_max.load(std::memory_order_relaxed);
+}
+
+double LatencyHistogram::mean() const noexcept
+{
+    const auto n = count();
+    return n == 0 ? 0.0 : static_cast<double>(total()) / static_cast<double>(n);
+}
+
+std::uint64_t LatencyHistogram::valueAt(const double quantile) const
+{
+    if (!(quantile >= 0.0 && quantile <= 1.0)) {
+        throw std::out_of_range("A quantile must be in [0, 1]!");
+    }
+    // The sum of the buckets, not m_count, in case a value is being
+    // recorded.
+    auto n = std::uint64_t{0};
+    for (const auto& b: m_buckets) {
+        n += b.load(std::memory_order_relaxed);
+    }
+    if (n == 0) {
+        return 0;
+    }
+    const auto rank = std::max(std::uint64_t{1},
+                               static_cast<std::uint64_t>(std::ceil(quantile * n)));
+    auto seen = std::uint64_t{0};
+    for (auto i = std::size_t{0}; i < bucketCount; ++i) {
+        seen += m_buckets[i].load(std::memory_order_relaxed);
+        if (seen >= rank) {
+            return std::min(highestIn(i), max());
+        }
+    }
+    return max();
+}
+
+std::size_t LatencyHistogram::bucketOf(const std::uint64_t value) noexcept
+{
+    if (value < subBuckets) {
+        return static_cast<std::size_t>(value);
+    }
+    auto msb = 0;
+    for (auto v = value; v > 1; v >>= 1) {
+        ++msb;
+    }
+    // The top bits below the highest one pick the sub-bucket.
+    const auto shift = msb - subBucketBits;
+    const auto sub = static_cast<std::size_t>(value >> shift) - subBuckets;
+    return static_cast<std::size_t>(shift + 1) * subBuckets + sub;
+}
+
+std::uint64_t LatencyHistogram::highestIn(const std::size_t bucket) noexcept
+{
+    if (bucket < subBuckets) {
+        return bucket;
+    }
+    const auto shift = bucket / subBuckets - 1;
+    const auto first = static_cast<std::uint64_t>(bucket % subBuckets + subBuckets) << shift;
+    return first + ((std::uint64_t{1} << shift) - 1);
+}
+
+}  // namespace pabo
@@ -0,0 +1,99 @@
+/**
+    @file src/log_stream.cpp
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief Implementation of the LogStream class.
+*/
+
+#include "log_stream.h"
+#include <chrono>
+#include <deque>
+#include <ostream>
+#include <utility>  // move
+
+namespace pabo::train {
+
+namespace {
+// How many records the writer formats into one block.
+constexpr auto batchSize = std::size_t{256};
+// How long the writer sleeps when there is nothing to write.
+constexpr auto idleTime = std::chrono::microseconds{200};
+}  // namespace
+
+LogStream::LogStream(std::ostream& os, const Printer& printer, std::size_t capacity)
+    : m_printer{printer}, m_ring{capacity}
+{
+    m_printer.setOstream(os);
+    m_writer = std::thread{[this] { run(); }};
+}
+
+LogStream::~LogStream()
+{
+    m_done = true;
+    if (m_writer.joinable()) {
+        m_writer.join();
+    }
+}
+
+void LogStream::write(TrainRecord tr)
+{
+    while (!m_ring.tryPush(tr)) {
+        std::this_thread::yield();
+    }
+}
+
+void LogStream::finish()
+{
+    m_done = true;
+    if (m_writer.joinable()) {
+        m_writer.join();
+    }
+    if (m_error) {
+        std::rethrow_exception(m_error);
+    }
+    m_printer.ostream().flush();
+}
+
+void LogStream::run()
+{
+    auto batch = std::deque<TrainRecord>{};
+    try {
+        for (;;) {
+            // Read the flag first, the records logged before it was set
+            // are then in the ring.
+            const auto done = m_done.load();
+            while (batch.size() < batchSize) {
+                auto tr = m_ring.tryPop();
+                if (!tr) { break; }
+                batch.emplace_back(std::move(*tr));
+            }
+            if (!batch.empty()) {
+                m_printer.print(batch.cbegin(), batch.cend());
+                batch.clear();
+            }
+            else if (done) {
+                return;
+            }
+            else {
+                std::this_thread::sleep_for(idleTime);
+            }
+        }
+    }
+    catch (...) {
+        m_error = std::current_exception();
+    }
+    // Keep the ring empty so that the logging thread never waits for
+    // a writer that has stopped.
+    for (;;) {
+        const auto done = m_done.load();
+        while (m_ring.tryPop()) {
+        }
+        if (done) {
+            return;
+        }
+        std::this_thread::sleep_for(idleTime);
+    }
+}
+
+}  // namespace pabo::train
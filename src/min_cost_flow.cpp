@@ -0,0 +1,121 @@
+/**
+    @file src/min_cost_flow.cpp
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief Implementation of the MinCostFlow class.
+*/
+
+#include "min_cost_flow.h"
+#include <algorithm>  // fill, min
+#include <functional>  // greater
+#include <limits>  // numeric_limits
+#include <queue>  // priority_queue
+#include <stdexcept>  // invalid_argument, out_of_range
+#include <utility>  // pair
+#include <vector>
+
+namespace pabo {
+
+namespace {
+constexpr auto infinite = std::numeric_limits<MinCostFlow::Amount>::max();
+constexpr auto none = std::numeric_limits<std::size_t>::max();
+}  // namespace
+
+MinCostFlow::MinCostFlow(const std::size_t nodes)
+    : m_out(nodes)
+{
+}
+
+MinCostFlow::Node MinCostFlow::addNode()
+{
+    m_out.emplace_back();
+    return m_out.size() - 1;
+}
+
+std::size_t MinCostFlow::nodeCount() const noexcept
+{
+    return m_out.size();
+}
+
+MinCostFlow::Edge MinCostFlow::addEdge(Node from, Node to, Amount capacity, Amount cost)
+{
+    if (from >= m_out.size() || to >= m_out.size()) {
+        throw std::out_of_range("No such node in the flow network!");
+    }
+    // Dijkstra needs the reduced costs to start out non-negative.
+    if (capacity < 0 || cost < 0) {
+        throw std::invalid_argument("Capacity and cost must not be negative!");
+    }
+    const auto e = m_arcs.size();
+    m_arcs.push_back({to, capacity, cost});
+    m_arcs.push_back({from, 0, -cost});
+    m_out[from].push_back(e);
+    m_out[to].push_back(e + 1);
+    return e / 2;
+}
+
+MinCostFlow::Result MinCostFlow::solve(Node source, Node sink)
+{
+    if (source >= m_out.size() || sink >= m_out.size()) {
+        throw std::out_of_range("No such node in the flow network!");
+    }
+    m_potential.assign(m_out.size(), 0);
+    auto res = Result{};
+    while (findShortestPath(source, sink)) {
+        for (auto n = Node{0}; n < m_out.size(); ++n) {
+            if (m_dist[n] != infinite) {
+                m_potential[n] += m_dist[n];
+            }
+        }
+
+        auto pushed = infinite;
+        for (auto n = sink; n != source; n = m_arcs[m_prevArc[n] ^ 1].to) {
+            pushed = std::min(pushed, m_arcs[m_prevArc[n]].capacity);
+        }
+        for (auto n = sink; n != source; n = m_arcs[m_prevArc[n] ^ 1].to) {
+            m_arcs[m_prevArc[n]].capacity -= pushed;
+            m_arcs[m_prevArc[n] ^ 1].capacity += pushed;
+            res.cost += pushed * m_arcs[m_prevArc[n]].cost;
+        }
+        res.flow += pushed;
+    }
+    return res;
+}
+
+MinCostFlow::Amount MinCostFlow::flow(Edge e) const
+{
+    return m_arcs.at(2 * e + 1).capacity;
+}
+
+bool MinCostFlow::findShortestPath(Node source, Node sink)
+{
+    m_dist.assign(m_out.size(), infinite);
+    m_prevArc.assign(m_out.size(), none);
+    using Entry = std::pair<Amount, Node>;
+    auto queue = std::priority_queue<Entry, std::vector<Entry>, std::greater<>>{};
+    m_dist[source] = 0;
+    queue.push({0, source});
+    while (!queue.empty()) {
+        const auto [dist, n] = queue.top();
+        queue.pop();
+        if (dist > m_dist[n]) {
+            continue;
+        }
+        for (const auto a: m_out[n]) {
+            const auto& arc = m_arcs[a];
+            if (arc.capacity <= 0) {
+                continue;
+            }
+            const auto reduced = arc.cost + m_potential[n] - m_potential[arc.to];
+            if (dist + reduced < m_dist[arc.to]) {
+                m_dist[arc.to] = dist + reduced;
+                m_prevArc[arc.to] = a;
+                queue.push({m_dist[arc.to], arc.to});
+            }
+        }
+    }
+    return m_dist[sink] != infinite;
+}
+
+}  // namespace pabo
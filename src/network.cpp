@@ -0,0 +1,27 @@
+/**
+    @file src/network.cpp
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief Implementation of the Network struct.
+*/
+
+#include "network.h"
+#include <utility>  // move
+
+namespace pabo::train {
+
+Network::Network(std::vector<TrainConnection> conns, std::vector<Path> paths,
+                 RouteTable table)
+    : connections{std::move(conns)}
+    , map{std::move(paths)}
+    , routes{std::move(table)}
+    , timetable{connections}
+{
+    profiles.reserve(connections.size());
+    for (const auto& c: connections) {
+        profiles.push_back(routes.profile(c.origin(), c.destination()));
+    }
+}
+
+}  // namespace pabo::train
@@ -0,0 +1,97 @@
+/**
+    @file src/output_buffer.cpp
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief Implementation of the OutputBuffer class.
+*/
+
+#include "output_buffer.h"
+#include <algorithm>  // copy, max
+#include <charconv>  // to_chars
+#include <ostream>
+
+namespace pabo::train {
+
+namespace {
+// The longest formatted number.
+constexpr auto maxNumberLength = std::size_t{32};
+}  // namespace
+
+OutputBuffer::OutputBuffer(std::ostream& os, std::vector<char>& storage)
+    : m_os{os}, m_buffer{storage}
+{
+    if (m_buffer.size() < blockSize) {
+        m_buffer.resize(blockSize);
+    }
+}
+
+OutputBuffer::~OutputBuffer()
+{
+    flush();
+}
+
+void OutputBuffer::flush()
+{
+    m_os.write(m_buffer.data(), static_cast<std::streamsize>(m_size));
+    m_size = 0;
+}
+
+char* OutputBuffer::reserve(std::size_t n)
+{
+    if (m_size + n > m_buffer.size()) {
+        flush();
+        if (n > m_buffer.size()) {
+            m_buffer.resize(std::max(n, 2 * m_buffer.size()));
+        }
+    }
+    return m_buffer.data() + m_size;
+}
+
+OutputBuffer& OutputBuffer::operator<<(std::string_view str)
+{
+    auto* out = reserve(str.size());
+    std::copy(str.begin(), str.end(), out);
+    m_size += str.size();
+    return *this;
+}
+
+OutputBuffer& OutputBuffer::operator<<(char c)
+{
+    *reserve(1) = c;
+    ++m_size;
+    return *this;
+}
+
+OutputBuffer& OutputBuffer::operator<<(int value)
+{
+    auto* out = reserve(maxNumberLength);
+    const auto res = std::to_chars(out, out + maxNumberLength, value);
+    m_size += static_cast<std::size_t>(res.ptr - out);
+    return *this;
+}
+
+OutputBuffer& OutputBuffer::operator<<(const time::TimeOfDay& tod)
+{
+    auto* out = reserve(5);
+    const auto twoDigits = [](char* pos, int value) {
+        pos[0] = static_cast<char>('0' + value / 10);
+        pos[1] = static_cast<char>('0' + value % 10);
+    };
+    twoDigits(out, tod.hour());
+    out[2] = time::delim;
+    twoDigits(out + 3, tod.minute());
+    m_size += 5;
+    return *this;
+}
+
+OutputBuffer& OutputBuffer::operator<<(const Capacity<double>& cap)
+{
+    auto* out = reserve(maxNumberLength);
+    const auto res = std::to_chars(out, out + maxNumberLength, cap.value,
+                                   std::chars_format::fixed, 0);
+    m_size += static_cast<std::size_t>(res.ptr - out);
+    return *this << ' ' << std::string_view{cap.unit};
+}
+
+}  // namespace pabo::train
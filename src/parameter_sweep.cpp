@@ -0,0 +1,143 @@
+/**
+    @file src/parameter_sweep.cpp
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief Implementation of the ParameterSweep class.
+*/
+
+#include "parameter_sweep.h"
+#include "thread_pool.h"
+#include <iostream>
+#include <stdexcept>  // invalid_argument
+#include <utility>  // move
+
+namespace pabo::app {
+
+using Duration = SimConfig::Duration;
+
+//
+// SweepGrid
+//
+
+void SweepGrid::setValues(const std::string& name, std::vector<int> minutes)
+{
+    if (name == "assembly") {
+        departureToAssembly = std::move(minutes);
+    }
+    else if (name == "ready") {
+        assembledToReady = std::move(minutes);
+    }
+    else if (name == "retry") {
+        assemblyAttempts = std::move(minutes);
+    }
+    else if (name == "departure") {
+        readyToDeparture = std::move(minutes);
+    }
+    else if (name == "disassembly") {
+        arrivalToDisassembly = std::move(minutes);
+    }
+    else {
+        throw std::invalid_argument("No such sweep parameter: " + name);
+    }
+}
+
+// Replaces every configuration with one copy per value, where the
+// copy has the member set to that value.
+void expand(std::vector<SimConfig>& configs,
+            const std::vector<int>& minutes,
+            Duration SimConfig::*member)
+{
+    if (minutes.empty()) {
+        return;
+    }
+    auto res = std::vector<SimConfig>{};
+    res.reserve(configs.size() * minutes.size());
+    for (const auto& config: configs) {
+        for (const auto value: minutes) {
+            auto tmp = config;
+            tmp.*member = Duration{value};
+            res.push_back(tmp);
+        }
+    }
+    configs = std::move(res);
+}
+
+std::vector<SimConfig> SweepGrid::configurations() const
+{
+    auto res = std::vector<SimConfig>{SimConfig{}};
+    expand(res, departureToAssembly, &SimConfig::timeBetweenDepartureAndAssembly);
+    expand(res, assembledToReady, &SimConfig::timeBetweenAssembledAndReady);
+    expand(res, assemblyAttempts, &SimConfig::timeBetweenAssemblyAttempts);
+    expand(res, readyToDeparture, &SimConfig::timeBetweenReadyAndDeparture);
+    expand(res, arrivalToDisassembly, &SimConfig::timeBetweenArrivalAndDisassembly);
+    return res;
+}
+
+//
+// ParameterSweep
+//
+
+ParameterSweep::ParameterSweep(std::shared_ptr<const train::Network> network,
+                               std::vector<train::Station> fleet)
+    : m_runner{std::move(network), std::move(fleet)}
+{
+}
+
+void ParameterSweep::setTimeSpan(time::TimeOfDay start, time::TimeOfDay end)
+{
+    if (end < start) {
+        throw std::out_of_range("End time earlier than start time!");
+    }
+    m_start = start;
+    m_end = end;
+}
+
+std::vector<SweepResult> ParameterSweep::run(const std::vector<SimConfig>& configs,
+                                             ThreadPool& pool) const
+{
+    // Validate up front so that a bad grid fails before any work is done.
+    for (const auto& config: configs) {
+        config.validate();
+    }
+    auto res = std::vector<SweepResult>(configs.size());
+    pool.parallelFor(configs.size(), [this, &configs, &res](std::size_t i) {
+        res[i] = runOne(configs[i]);
+    });
+    return res;
+}
+
+SweepResult ParameterSweep::runOne(const SimConfig& config) const
+{
+    auto scenario = Scenario{};
+    scenario.start = m_start;
+    scenario.end = m_end;
+    scenario.config = config;
+    const auto result = m_runner.runOne(scenario);
+    return {config,
+            result.totalDepartureDelay,
+            result.totalArrivalDelay,
+            result.completedTrains};
+}
+
+//
+// Non-members
+//
+
+void writeCsv(std::ostream& os, const std::vector<SweepResult>& results)
+{
+    os << "assembly,ready,retry,departure,disassembly,"
+       << "total_departure_delay,total_arrival_delay,completed_trains\n";
+    for (const auto& [config, departureDelay, arrivalDelay, completed]: results) {
+        os << config.timeBetweenDepartureAndAssembly.rawTime() << ','
+           << config.timeBetweenAssembledAndReady.rawTime() << ','
+           << config.timeBetweenAssemblyAttempts.rawTime() << ','
+           << config.timeBetweenReadyAndDeparture.rawTime() << ','
+           << config.timeBetweenArrivalAndDisassembly.rawTime() << ','
+           << departureDelay.rawTime() << ','
+           << arrivalDelay.rawTime() << ','
+           << completed << '\n';
+    }
+}
+
+}  // namespace pabo::app
@@ -1,22 +1,34 @@
 #include "path.h"
+#include "station_id.h"
 #include <iostream>
+#include <sstream>  // istringstream
+#include <string>
+#include <string_view>
 #include <utility>
 
 namespace pabo::train {
 
-Path::Path(std::string a, std::string b, double distance /* = 0 */)
-    : m_pointA{std::move(a)}
-    , m_pointB{std::move(b)}
+Path::Path(std::string_view a, std::string_view b, double distance /* = 0 */,
+           double speedLimit /* = noSpeedLimit */)
+    : Path{internStation(a), internStation(b), distance, speedLimit}
+{
+}
+
+Path::Path(StationId a, StationId b, double distance /* = 0 */,
+           double speedLimit /* = noSpeedLimit */)
+    : m_pointA{a}
+    , m_pointB{b}
     , m_distance{distance, "km"}
+    , m_speedLimit{speedLimit, "kph"}
 {
 }
 
-std::string Path::pointA() const
+StationId Path::pointA() const
 {
     return m_pointA;
 }
 
-std::string Path::pointB() const
+StationId Path::pointB() const
 {
     return m_pointB;
 }
@@ -26,6 +38,16 @@ Capacity<double> Path::distance() const
     return m_distance;
 }
 
+Capacity<double> Path::speedLimit() const
+{
+    return m_speedLimit;
+}
+
+bool Path::hasSpeedLimit() const
+{
+    return m_speedLimit.value != noSpeedLimit;
+}
+
 bool operator==(const Path& lhs, const Path& rhs)
 {
     return (lhs.pointA() == rhs.pointA() && lhs.pointB() == rhs.pointB()) ||
@@ -34,19 +56,35 @@ bool operator==(const Path& lhs, const Path& rhs)
 
 std::ostream& operator<<(std::ostream& os, const Path& p)
 {
-    return os << p.pointA() << ' ' << p.pointB() << ' ' << p.distance();
+    os << stationName(p.pointA()) << ' ' << stationName(p.pointB()) << ' ' << p.distance();
+    if (p.hasSpeedLimit()) {
+        os << ' ' << p.speedLimit();
+    }
+    return os;
 }
 
 std::istream& operator>>(std::istream& is, Path& p)
 {
+    // The speed limit is optional, so a path is read a line at a time.
+    auto line = std::string{};
+    if (!std::getline(is >> std::ws, line)) { return is; }
+
+    auto fields = std::istringstream{line};
     auto pointA = std::string{};
     auto pointB = std::string{};
     auto distance = double{};
+    fields >> pointA >> pointB >> distance;
+    if (fields.fail()) {
+        is.setstate(std::ios::failbit);
+        return is;
+    }
+    auto speedLimit = Path::noSpeedLimit;
+    if (!(fields >> std::ws).eof() && !(fields >> speedLimit)) {
+        is.setstate(std::ios::failbit);
+        return is;
+    }
 
-    is >> pointA >> pointB >> distance;
-    if (is.fail()) { return is; }
-
-    auto tmp = Path(pointA, pointB, distance);
+    auto tmp = Path(pointA, pointB, distance, speedLimit);
     using std::swap;
     swap(tmp, p);
 
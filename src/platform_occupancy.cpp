@@ -0,0 +1,166 @@
+/**
+    @file src/platform_occupancy.cpp
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief Implementation of the PlatformOccupancy class.
+*/
+
+#include "platform_occupancy.h"
+#include <algorithm>  // max, max_element, upper_bound
+#include <iterator>  // prev
+#include <stdexcept>  // invalid_argument, logic_error
+#include <utility>  // pair
+#include <vector>
+
+namespace pabo::train {
+
+PlatformOccupancy::PlatformOccupancy(const int platforms)
+    : m_platforms{platforms}
+{
+    if (platforms < 0) {
+        throw std::invalid_argument("A station can not have a negative number of platforms!");
+    }
+}
+
+int PlatformOccupancy::platforms() const noexcept
+{
+    return m_platforms;
+}
+
+bool PlatformOccupancy::isLimited() const noexcept
+{
+    return m_platforms > 0;
+}
+
+int PlatformOccupancy::occupied() const noexcept
+{
+    return m_occupied;
+}
+
+int PlatformOccupancy::waitingCount() const noexcept
+{
+    return static_cast<int>(m_waiting.size());
+}
+
+int PlatformOccupancy::peak() const noexcept
+{
+    return m_peak;
+}
+
+int PlatformOccupancy::occupiedAt(const int time) const
+{
+    const auto after = std::upper_bound(m_timeline.begin(), m_timeline.end(), time,
+                                        [](int t, const Change& c) { return t < c.time; });
+    return after == m_timeline.begin() ? 0 : std::prev(after)->occupied;
+}
+
+long PlatformOccupancy::busyMinutes(const int begin, const int end) const
+{
+    return end <= begin ? 0 : busyBefore(end) - busyBefore(begin);
+}
+
+double PlatformOccupancy::averageOccupied(const int begin, const int end) const
+{
+    if (end <= begin) {
+        return 0.0;
+    }
+    return static_cast<double>(busyMinutes(begin, end)) / (end - begin);
+}
+
+double PlatformOccupancy::averageOccupied() const
+{
+    if (m_timeline.empty()) {
+        return 0.0;
+    }
+    return averageOccupied(m_timeline.front().time, m_timeline.back().time);
+}
+
+bool PlatformOccupancy::take(const int time, const int trainNbr)
+{
+    if (isLimited() && m_occupied >= m_platforms) {
+        m_waiting.push_back({trainNbr, time});
+        return false;
+    }
+    ++m_occupied;
+    record(time, 1);
+    return true;
+}
+
+std::optional<PlatformOccupancy::Waiter> PlatformOccupancy::leave(
+        const int time, const std::function<bool(const Waiter&)>& accept)
+{
+    if (m_occupied == 0) {
+        throw std::logic_error("No train is at a platform!");
+    }
+    if (!m_waiting.empty() && accept(m_waiting.front())) {
+        // The platform changes trains, the number of trains does not.
+        const auto res = m_waiting.front();
+        m_waiting.pop_front();
+        return res;
+    }
+    --m_occupied;
+    record(time, -1);
+    return std::nullopt;
+}
+
+std::vector<PlatformOccupancy::Waiter> PlatformOccupancy::takeWaiters()
+{
+    auto res = std::vector<Waiter>(m_waiting.begin(), m_waiting.end());
+    m_waiting.clear();
+    return res;
+}
+
+void PlatformOccupancy::record(const int time, const int change)
+{
+    if (m_timeline.empty() || m_timeline.back().time < time) {
+        const auto [occupied, busy] = m_timeline.empty()
+                ? std::pair{0, 0L}
+                : std::pair{m_timeline.back().occupied, busyBefore(time)};
+        m_timeline.push_back({time, occupied + change, busy});
+        m_peak = std::max(m_peak, occupied + change);
+        return;
+    }
+    if (m_timeline.back().time == time) {
+        m_timeline.back().occupied += change;
+        m_peak = std::max(m_peak, m_timeline.back().occupied);
+        return;
+    }
+
+    // The change at the time, or a new one after the changes before it,
+    // and every change after it are updated.
+    auto first = std::upper_bound(m_timeline.begin(), m_timeline.end(), time,
+                                  [](int t, const Change& c) { return t < c.time; });
+    if (first != m_timeline.begin() && std::prev(first)->time == time) {
+        --first;
+    }
+    else {
+        const auto occupied = first == m_timeline.begin() ? 0 : std::prev(first)->occupied;
+        first = m_timeline.insert(first, {time, occupied, busyBefore(time)});
+    }
+    for (auto c = first; c != m_timeline.end(); ++c) {
+        c->occupied += change;
+        if (c != m_timeline.begin()) {
+            const auto& before = *std::prev(c);
+            c->busyBefore = before.busyBefore +
+                            static_cast<long>(before.occupied) * (c->time - before.time);
+        }
+    }
+    m_peak = std::max_element(m_timeline.begin(), m_timeline.end(),
+                              [](const Change& lhs, const Change& rhs) {
+                                  return lhs.occupied < rhs.occupied;
+                              })->occupied;
+}
+
+long PlatformOccupancy::busyBefore(const int time) const
+{
+    const auto after = std::upper_bound(m_timeline.begin(), m_timeline.end(), time,
+                                        [](int t, const Change& c) { return t < c.time; });
+    if (after == m_timeline.begin()) {
+        return 0;
+    }
+    const auto& c = *std::prev(after);
+    return c.busyBefore + static_cast<long>(c.occupied) * (time - c.time);
+}
+
+}  // namespace pabo::train
@@ -8,8 +8,12 @@
 
 #include "capacity.h"
 #include "car_log.h"
+#include "departure_board.h"
+#include "output_buffer.h"
 #include "printer.h"
+#include "scope_trace.h"
 #include "station.h"
+#include "station_id.h"
 #include "time_point.h"
 #include "train.h"
 #include "train_dispatcher.h"
@@ -74,45 +78,41 @@ std::string Printer::logLevelAsString() const
 
 void Printer::print(const TrainRecord& tr)
 {
-    const auto& [time, train, currentEvent] = tr;
-
-    *os << '\n' << time;
-    print(*train);
-    *os << currentEvent << '\n';
+    PABO_TRACE_SCOPE("Printer::print(TrainRecord)");
+    auto out = OutputBuffer{*os, m_buffer};
+    format(out, tr);
 }
 
 void Printer::print(const Train& train)
 {
-    const auto nbr = train.number();
-    const auto state = train.state();
-
-    const auto origin = m_disp.origin(nbr);
-    const auto destination = m_disp.destination(nbr);
-
-    const auto schedDeparture = m_disp.scheduledTimeOfDeparture(nbr);
-    const auto schedArrival = m_disp.scheduledTimeOfArrival(nbr);
-    const auto estDeparture = train.departure();
-    const auto estArrival = m_disp.estimatedTimeOfArrival(train);
-    const auto departureDelay = m_disp.departureDelay(train);
-    const auto arrivalDelay = m_disp.arrivalDelay(train);
+    PABO_TRACE_SCOPE("Printer::print(Train)");
+    auto out = OutputBuffer{*os, m_buffer};
+    format(out, TrainSummary{train, m_disp});
+}
 
-    const auto speed = train.currentSpeed();
-    const auto maxSpeed = m_disp.maxSpeed(nbr);
+void Printer::format(OutputBuffer& out, const TrainRecord& tr) const
+{
+    out << '\n' << tr.time;
+    format(out, tr.train);
+    out << tr.eventDescription << '\n';
+}
 
-    *os << std::fixed << std::setprecision(0)
-        << "\nTrain [" << nbr << "] (" << state << ")\n";
+void Printer::format(OutputBuffer& out, const TrainSummary& train) const
+{
+    out << "\nTrain [" << train.number << "] ("
+        << toString(train.state) << ")\n";
 
     if (m_logLvl >= LogLevel::medium) {
-        *os << "from " << origin << ' '
-            << schedDeparture << " (" << estDeparture << ")"
+        out << "from " << stationName(train.origin) << ' '
+            << train.scheduledDeparture << " (" << train.estimatedDeparture << ")"
 
-            << " to " << destination << ' '
-            << schedArrival << " (" << estArrival <<  ") \n";
+            << " to " << stationName(train.destination) << ' '
+            << train.scheduledArrival << " (" << train.estimatedArrival << ") \n";
 
         if (logLevel() == LogLevel::high) {
-            *os << "departure delay " << departureDelay << " "
-                << "arrival delay " << arrivalDelay << " "
-                << "Speed " << speed << '\n';
+            out << "departure delay " << train.departureDelay << " "
+                << "arrival delay " << train.arrivalDelay << " "
+                << "Speed " << train.speed << '\n';
         }
     }
 }
@@ -157,21 +157,24 @@ void Printer::println(const std::string& str) const
 
 void Printer::print(Iterator first, Iterator last)
 {
-    std::for_each(first, last, [this](const TrainRecord& tr) {
-        print(tr);
+    PABO_TRACE_SCOPE("Printer::print(records)");
+    auto out = OutputBuffer{*os, m_buffer};
+    std::for_each(first, last, [this, &out](const TrainRecord& tr) {
+        format(out, tr);
     });
 }
 
 void Printer::print(const Station& stn)
 {
+    PABO_TRACE_SCOPE("Printer::print(Station)");
     const auto stnName = stn.name();
     println("----");
-    println(stnName);
+    println(std::string{stnName});
     println("----");
 
     println("Trains at station");
     print("-----------------");
-    const auto trains = m_disp.trainsAtStation(stnName);
+    const auto trains = m_disp.trainsAtStation(stn.id());
     if (trains.empty()) {
         println("[no trains]");
     }
@@ -182,6 +185,18 @@ void Printer::print(const Station& stn)
     }
     println();
 
+    const auto& platforms = stn.platforms();
+    println("Platforms");
+    println("---------");
+    println("Platforms: " + (platforms.isLimited() ? std::to_string(platforms.platforms())
+                                                    : std::string{"no limit"}));
+    println("Trains at the platforms: " + std::to_string(platforms.occupied()) +
+            ", waiting: " + std::to_string(platforms.waitingCount()) +
+            ", at most: " + std::to_string(platforms.peak()));
+    *os << std::fixed << std::setprecision(2)
+        << "Average trains at the platforms: " << platforms.averageOccupied() << '\n';
+    println();
+
     if (logLevel() >= LogLevel::medium) {
         println("Available cars");
         println("--------------");
@@ -198,6 +213,55 @@ void Printer::print(const Station& stn)
     }
 }
 
+void Printer::printDepartures(Timetable::Entries departures)
+{
+    PABO_TRACE_SCOPE("Printer::printDepartures");
+    if (departures.empty()) {
+        println("[no departures]");
+        return;
+    }
+    auto out = OutputBuffer{*os, m_buffer};
+    for (const auto& e: departures) {
+        const auto train = TrainSummary{m_disp.viewTrain(e), m_disp};
+        out << train.scheduledDeparture << " (" << train.estimatedDeparture << ") ["
+            << train.number << "] to " << stationName(train.destination) << ' '
+            << toString(train.state) << '\n';
+    }
+}
+
+void Printer::printArrivals(Timetable::Entries arrivals)
+{
+    PABO_TRACE_SCOPE("Printer::printArrivals");
+    if (arrivals.empty()) {
+        println("[no arrivals]");
+        return;
+    }
+    auto out = OutputBuffer{*os, m_buffer};
+    for (const auto& e: arrivals) {
+        const auto train = TrainSummary{m_disp.viewTrain(e), m_disp};
+        out << train.scheduledArrival << " (" << train.estimatedArrival << ") ["
+            << train.number << "] from " << stationName(train.origin) << ' '
+            << toString(train.state) << '\n';
+    }
+}
+
+void Printer::print(const DepartureBoard& board)
+{
+    PABO_TRACE_SCOPE("Printer::print(DepartureBoard)");
+    println("Departures from " + std::string{stationName(board.station())});
+    const auto rows = board.rows();
+    if (rows.empty()) {
+        println("[no departures]");
+        return;
+    }
+    auto out = OutputBuffer{*os, m_buffer};
+    for (const auto& r: rows) {
+        out << r.scheduled << " (" << r.estimated << ") [" << r.trainNbr << "] to "
+            << stationName(r.destination) << " delay " << r.delay << ' '
+            << toString(r.state) << '\n';
+    }
+}
+
 void Printer::printCarWithLocation(const Car& car)
 {
     print(car);
@@ -216,6 +280,7 @@ void Printer::print(const Car& car)
 
 void Printer::printCarFeatures(const Car& car)
 {
+    *os << std::fixed << std::setprecision(0);
     if (car.hasEngine()) {
         *os << ", max speed: " << car.maxSpeed();
         if (car.fuelConsumption() > 0.0) {
@@ -243,8 +308,13 @@ void Printer::printCarFeatures(const Car& car)
 
 void Printer::print(const CarRecord& rec)
 {
-    const auto& [time, train, destination] = rec;
-    *os << time << ": train[" << train << "] -> " << destination << '\n';
+    PABO_TRACE_SCOPE("Printer::print(CarRecord)");
+    const auto destination = stationName(rec.destination);
+    if (rec.trainNbr == 0) {
+        *os << rec.time() << ": moved empty -> " << destination << '\n';
+        return;
+    }
+    *os << rec.time() << ": train[" << rec.trainNbr << "] -> " << destination << '\n';
 }
 
 }  // namespace pabo::train
@@ -0,0 +1,236 @@
+/**
+    @file src/repositioning.cpp
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief Implementation of the planning of empty car moves.
+*/
+
+#include "min_cost_flow.h"
+#include "repositioning.h"
+#include "station.h"
+#include "station_id.h"
+#include "train.h"
+#include "train_dispatcher.h"
+#include "vehicle_type.h"
+#include <algorithm>  // find, lower_bound, max, min, stable_sort
+#include <cmath>  // lround
+#include <cstddef>  // size_t
+#include <vector>
+
+namespace pabo::train {
+
+namespace {
+
+using Flow = MinCostFlow;
+
+// The cars of a type that the trains return to and take from a
+// station at a time.
+struct Change {
+    int time;
+    int returned;
+    int taken;
+};
+
+// The nodes of a station in a time-expanded network, in time order.
+struct Timeline {
+    std::vector<int> times;
+    std::vector<Flow::Node> nodes;
+};
+
+struct Route {
+    int minutes;
+    Flow::Amount cost;
+};
+
+struct TransferEdge {
+    Flow::Edge edge;
+    std::size_t from;
+    std::size_t to;
+    int departure;
+    int arrival;
+};
+
+class TypePlanner {
+public:
+    TypePlanner(const TrainDispatcher& disp, const SimConfig& config,
+                const std::vector<StationId>& stations,
+                const std::vector<std::vector<Route>>& routes)
+        : m_disp{disp}, m_config{config}, m_stations{stations}, m_routes{routes}
+    {
+    }
+
+    std::vector<Transfer> plan(Vehicle::Type type);
+
+private:
+    [[nodiscard]] std::vector<std::vector<Change>> changesOf(Vehicle::Type type) const;
+    void addTimeline(std::vector<Change> changes);
+    void addTransferEdges(std::size_t from, std::size_t to);
+
+    const TrainDispatcher& m_disp;
+    const SimConfig& m_config;
+    const std::vector<StationId>& m_stations;
+    const std::vector<std::vector<Route>>& m_routes;
+
+    Flow m_flow{2};
+    const Flow::Node m_source{0};
+    const Flow::Node m_sink{1};
+    Flow::Amount m_cars{0};
+    std::vector<Timeline> m_timelines;
+    std::vector<TransferEdge> m_transfers;
+};
+
+std::vector<Transfer> TypePlanner::plan(const Vehicle::Type type)
+{
+    auto changes = changesOf(type);
+    for (const auto& c: changes) {
+        for (const auto& change: c) {
+            m_cars += change.returned;
+        }
+    }
+    for (auto& c: changes) {
+        addTimeline(std::move(c));
+    }
+    for (auto from = std::size_t{0}; from < m_stations.size(); ++from) {
+        for (auto to = std::size_t{0}; to < m_stations.size(); ++to) {
+            if (from != to && m_routes[from][to].minutes >= 0) {
+                addTransferEdges(from, to);
+            }
+        }
+    }
+
+    m_flow.solve(m_source, m_sink);
+
+    auto res = std::vector<Transfer>{};
+    for (const auto& t: m_transfers) {
+        const auto count = m_flow.flow(t.edge);
+        if (count > 0) {
+            res.push_back({type, static_cast<int>(count),
+                           m_stations[t.from], m_stations[t.to],
+                           time::TimeOfDay{t.departure}, time::TimeOfDay{t.arrival}});
+        }
+    }
+    return res;
+}
+
+std::vector<std::vector<Change>> TypePlanner::changesOf(const Vehicle::Type type) const
+{
+    auto indexOf = [this](const StationId id) {
+        return static_cast<std::size_t>(
+                std::find(m_stations.begin(), m_stations.end(), id) - m_stations.begin());
+    };
+
+    auto res = std::vector<std::vector<Change>>(m_stations.size());
+    auto first = 0;
+    for (const auto nbr: m_disp.trainNumbers()) {
+        const auto count = m_disp.viewTrain(nbr).missingCount(type);
+        if (count < 1) {
+            continue;
+        }
+        const auto assembly = m_disp.scheduledTimeOfDeparture(nbr) -
+                              m_config.timeBetweenDepartureAndAssembly;
+        const auto disassembly = m_disp.scheduledTimeOfArrival(nbr) +
+                                 m_config.timeBetweenArrivalAndDisassembly;
+        res[indexOf(m_disp.origin(nbr))].push_back({assembly.rawTime(), 0, count});
+        res[indexOf(m_disp.destination(nbr))].push_back({disassembly.rawTime(), count, 0});
+        first = std::min(first, assembly.rawTime());
+    }
+    // The pools are there before any train is assembled.
+    for (auto i = std::size_t{0}; i < m_stations.size(); ++i) {
+        const auto pool = m_disp.viewStation(m_stations[i]).carCount(type);
+        res[i].push_back({first, pool, 0});
+    }
+    return res;
+}
+
+void TypePlanner::addTimeline(std::vector<Change> changes)
+{
+    std::stable_sort(changes.begin(), changes.end(),
+                     [](const Change& lhs, const Change& rhs) {
+                         return lhs.time < rhs.time;
+                     });
+    auto timeline = Timeline{};
+    for (auto c = changes.begin(); c != changes.end();) {
+        auto returned = 0;
+        auto taken = 0;
+        const auto time = c->time;
+        for (; c != changes.end() && c->time == time; ++c) {
+            returned += c->returned;
+            taken += c->taken;
+        }
+        const auto node = m_flow.addNode();
+        if (returned > 0) {
+            m_flow.addEdge(m_source, node, returned, 0);
+        }
+        if (taken > 0) {
+            m_flow.addEdge(node, m_sink, taken, 0);
+        }
+        // The cars wait at the station until the next node.
+        if (!timeline.nodes.empty()) {
+            m_flow.addEdge(timeline.nodes.back(), node, m_cars, 0);
+        }
+        timeline.times.push_back(time);
+        timeline.nodes.push_back(node);
+    }
+    m_timelines.push_back(std::move(timeline));
+}
+
+void TypePlanner::addTransferEdges(const std::size_t from, const std::size_t to)
+{
+    const auto& source = m_timelines[from];
+    const auto& target = m_timelines[to];
+    const auto [minutes, cost] = m_routes[from][to];
+    // A move that reaches the same node as the move from the next node
+    // could as well wait for it. Only the latest move to each node is
+    // added, which keeps the number of edges linear in the nodes.
+    auto next = target.times.size();
+    for (auto i = source.times.size(); i-- > 0;) {
+        // Nothing moves before the start of the day.
+        const auto departure = std::max(source.times[i], 0);
+        const auto j = static_cast<std::size_t>(
+                std::lower_bound(target.times.begin(), target.times.end(),
+                                 departure + minutes) -
+                target.times.begin());
+        if (j == target.times.size() || j == next) {
+            continue;
+        }
+        next = j;
+        const auto edge = m_flow.addEdge(source.nodes[i], target.nodes[j], m_cars, cost);
+        m_transfers.push_back({edge, from, to, departure, departure + minutes});
+    }
+}
+
+}  // namespace
+
+std::vector<Transfer> planRepositioning(const TrainDispatcher& disp, const SimConfig& config)
+{
+    const auto stations = disp.stationIds();
+    const auto speed = Train::Speed{config.repositioningSpeed, "kph"};
+
+    // A negative time marks stations without a path between them.
+    auto routes = std::vector<std::vector<Route>>(stations.size(),
+                                                  std::vector<Route>(stations.size(), {-1, 0}));
+    for (auto from = std::size_t{0}; from < stations.size(); ++from) {
+        for (auto to = std::size_t{0}; to < stations.size(); ++to) {
+            if (from == to || !disp.hasPath(stations[from], stations[to])) {
+                continue;
+            }
+            const auto distance = disp.distance(stations[from], stations[to]);
+            const auto time = disp.travelTime(stations[from], stations[to], speed);
+            routes[from][to] = {time.rawTime(), std::lround(distance.value)};
+        }
+    }
+
+    auto res = std::vector<Transfer>{};
+    for (const auto type: vehicleTypes) {
+        auto planner = TypePlanner{disp, config, stations, routes};
+        auto transfers = planner.plan(type);
+        res.insert(res.end(), transfers.begin(), transfers.end());
+    }
+    std::stable_sort(res.begin(), res.end(), [](const Transfer& lhs, const Transfer& rhs) {
+        return lhs.departure < rhs.departure;
+    });
+    return res;
+}
+
+}  // namespace pabo::train
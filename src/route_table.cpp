@@ -0,0 +1,231 @@
+/**
+    @file src/route_table.cpp
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief Implementation of the RouteTable class.
+*/
+
+#include "route_table.h"
+#include "thread_pool.h"
+#include <functional>  // greater
+#include <limits>  // numeric_limits
+#include <queue>  // priority_queue
+#include <stdexcept>  // invalid_argument, out_of_range
+#include <string>
+#include <utility>  // pair
+#include <vector>
+
+namespace pabo::train {
+
+namespace {
+
+constexpr auto infinite = std::numeric_limits<double>::infinity();
+constexpr auto none = std::numeric_limits<std::size_t>::max();
+// Up to this many stations the cubic Floyd-Warshall beats running
+// Dijkstra from every station.
+constexpr auto denseLimit = std::size_t{256};
+
+// Calls task(i) for every i in [0, count), on the pool if there is one.
+template<typename Task>
+void forEach(app::ThreadPool* pool, std::size_t count, const Task& task)
+{
+    if (pool) {
+        pool->parallelFor(count, task);
+        return;
+    }
+    for (auto i = std::size_t{0}; i < count; ++i) {
+        task(i);
+    }
+}
+
+}  // namespace
+
+RouteTable::RouteTable(const std::vector<Path>& map)
+    : RouteTable{map, nullptr}
+{
+}
+
+RouteTable::RouteTable(const std::vector<Path>& map, app::ThreadPool& pool)
+    : RouteTable{map, &pool}
+{
+}
+
+RouteTable::RouteTable(const std::vector<Path>& map, app::ThreadPool* pool)
+{
+    for (const auto& p: map) {
+        if (p.distance().value < 0.0) {
+            throw std::invalid_argument("Negative distance between " +
+                                        std::string{stationName(p.pointA())} + " and " +
+                                        std::string{stationName(p.pointB())});
+        }
+        for (const auto id: {p.pointA(), p.pointB()}) {
+            if (id >= m_index.size()) {
+                m_index.resize(id + std::size_t{1}, none);
+            }
+            if (m_index[id] == none) {
+                m_index[id] = m_stations.size();
+                m_stations.push_back(id);
+            }
+        }
+    }
+
+    const auto n = m_stations.size();
+    m_edges.resize(n);
+    for (auto i = std::size_t{0}; i < map.size(); ++i) {
+        const auto& p = map[i];
+        const auto a = m_index[p.pointA()];
+        const auto b = m_index[p.pointB()];
+        const auto leg = Leg{i, p.distance().value, p.speedLimit().value};
+        m_edges[a].push_back({b, leg});
+        m_edges[b].push_back({a, leg});
+    }
+
+    m_distance.assign(n * n, infinite);
+    m_next.assign(n * n, noStation);
+    for (auto i = std::size_t{0}; i < n; ++i) {
+        m_distance[i * n + i] = 0.0;
+        m_next[i * n + i] = m_stations[i];
+    }
+
+    if (n <= denseLimit) {
+        for (auto a = std::size_t{0}; a < n; ++a) {
+            for (const auto& e: m_edges[a]) {
+                if (e.leg.distance < m_distance[a * n + e.to]) {
+                    m_distance[a * n + e.to] = e.leg.distance;
+                    m_next[a * n + e.to] = m_stations[e.to];
+                }
+            }
+        }
+        floydWarshall(pool);
+    }
+    else {
+        dijkstra(pool);
+    }
+}
+
+void RouteTable::floydWarshall(app::ThreadPool* pool)
+{
+    const auto n = m_stations.size();
+    for (auto k = std::size_t{0}; k < n; ++k) {
+        // Row k does not change in round k, so the rows can be relaxed
+        // in parallel.
+        forEach(pool, n, [this, n, k](std::size_t i) {
+            const auto viaK = m_distance[i * n + k];
+            if (viaK == infinite) {
+                return;
+            }
+            for (auto j = std::size_t{0}; j < n; ++j) {
+                const auto d = viaK + m_distance[k * n + j];
+                if (d < m_distance[i * n + j]) {
+                    m_distance[i * n + j] = d;
+                    m_next[i * n + j] = m_next[i * n + k];
+                }
+            }
+        });
+    }
+}
+
+void RouteTable::dijkstra(app::ThreadPool* pool)
+{
+    const auto n = m_stations.size();
+    // Every source fills its own row.
+    forEach(pool, n, [this, n](std::size_t source) {
+        auto* dist = &m_distance[source * n];
+        auto* next = &m_next[source * n];
+        using Entry = std::pair<double, std::size_t>;
+        auto queue = std::priority_queue<Entry, std::vector<Entry>, std::greater<>>{};
+        queue.emplace(0.0, source);
+        while (!queue.empty()) {
+            const auto [d, u] = queue.top();
+            queue.pop();
+            if (d > dist[u]) {
+                continue;
+            }
+            for (const auto& e: m_edges[u]) {
+                const auto v = e.to;
+                if (d + e.leg.distance < dist[v]) {
+                    dist[v] = d + e.leg.distance;
+                    next[v] = (u == source) ? m_stations[v] : next[u];
+                    queue.emplace(dist[v], v);
+                }
+            }
+        }
+    });
+}
+
+bool RouteTable::hasRoute(const StationId from, const StationId to) const noexcept
+{
+    const auto a = indexOf(from);
+    const auto b = indexOf(to);
+    return a != none && b != none && m_distance[a * m_stations.size() + b] != infinite;
+}
+
+RouteTable::Distance RouteTable::distance(const StationId from, const StationId to) const
+{
+    return {m_distance[cellOf(from, to)], "km"};
+}
+
+StationId RouteTable::nextHop(const StationId from, const StationId to) const
+{
+    return m_next[cellOf(from, to)];
+}
+
+std::vector<StationId> RouteTable::route(const StationId from, const StationId to) const
+{
+    auto res = std::vector<StationId>{from};
+    for (auto at = from; at != to;) {
+        at = nextHop(at, to);
+        res.push_back(at);
+    }
+    return res;
+}
+
+std::vector<RouteTable::Leg> RouteTable::legs(const StationId from, const StationId to) const
+{
+    const auto stations = route(from, to);
+    auto res = std::vector<Leg>{};
+    res.reserve(stations.size() - 1);
+    for (auto i = std::size_t{1}; i < stations.size(); ++i) {
+        // The route takes the shortest of parallel paths.
+        const auto next = indexOf(stations[i]);
+        const Edge* shortest = nullptr;
+        for (const auto& e: m_edges[indexOf(stations[i - 1])]) {
+            if (e.to == next && (!shortest || e.leg.distance < shortest->leg.distance)) {
+                shortest = &e;
+            }
+        }
+        res.push_back(shortest->leg);
+    }
+    return res;
+}
+
+SpeedProfile RouteTable::profile(const StationId from, const StationId to) const
+{
+    auto segments = std::vector<SpeedProfile::Segment>{};
+    for (const auto& leg: legs(from, to)) {
+        segments.push_back({leg.distance, leg.speedLimit});
+    }
+    return SpeedProfile{segments};
+}
+
+std::size_t RouteTable::stationCount() const noexcept
+{
+    return m_stations.size();
+}
+
+std::size_t RouteTable::indexOf(const StationId id) const noexcept
+{
+    return id < m_index.size() ? m_index[id] : none;
+}
+
+std::size_t RouteTable::cellOf(const StationId from, const StationId to) const
+{
+    if (!hasRoute(from, to)) {
+        throw std::out_of_range("No route between " + std::string{stationName(from)} +
+                                " and " + std::string{stationName(to)});
+    }
+    return indexOf(from) * m_stations.size() + indexOf(to);
+}
+
+}  // namespace pabo::train
@@ -0,0 +1,98 @@
+/**
+    @file src/scenario.cpp
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief Implementation of the ScenarioRunner class.
+*/
+
+#include "car_log.h"
+#include "scenario.h"
+#include "simulator.h"
+#include "start_event.h"
+#include "thread_pool.h"
+#include "train_dispatcher.h"
+#include "train_log.h"
+#include <algorithm>  // find_if
+#include <iostream>
+#include <memory>  // make_shared
+#include <stdexcept>  // out_of_range
+#include <utility>  // move
+
+namespace pabo::app {
+
+ScenarioRunner::ScenarioRunner(std::shared_ptr<const train::Network> network,
+                               std::vector<train::Station> fleet)
+    : m_network{std::move(network)}
+    , m_fleet{std::move(fleet)}
+{
+}
+
+std::vector<ScenarioResult> ScenarioRunner::run(const std::vector<Scenario>& scenarios,
+                                                ThreadPool& pool) const
+{
+    auto res = std::vector<ScenarioResult>(scenarios.size());
+    pool.parallelFor(scenarios.size(), [this, &scenarios, &res](std::size_t i) {
+        res[i] = runOne(scenarios[i]);
+    });
+    return res;
+}
+
+ScenarioResult ScenarioRunner::runOne(const Scenario& scenario) const
+{
+    auto dispatch = train::TrainDispatcher{m_network, fleetOf(scenario)};
+    auto log = train::TrainLog{};
+    auto carLog = train::CarLog{};
+    auto sim = Simulator{dispatch, log, carLog};
+    sim.setStartTime(scenario.start.asString());
+    sim.setEndTime(scenario.end.asString());
+    sim.setConfig(scenario.config);
+    sim.reset();
+
+    sim.scheduleEvent(std::make_shared<train::StartEvent>(sim, dispatch));
+    sim.runToCompletion();
+
+    return {scenario.name,
+            dispatch.totalDepartureDelay(),
+            dispatch.totalArrivalDelay(),
+            dispatch.finishedTrainCount()};
+}
+
+std::vector<train::Station> ScenarioRunner::fleetOf(const Scenario& scenario) const
+{
+    // Copying a station only copies the pointers to its vehicles.
+    auto fleet = scenario.fleet.empty() ? m_fleet : scenario.fleet;
+    for (const auto id: scenario.removedVehicles) {
+        const auto station = std::find_if(fleet.begin(), fleet.end(),
+                                          [id](const train::Station& s) {
+                                              return s.hasCar(id);
+                                          });
+        if (station == fleet.end()) {
+            throw std::out_of_range("No vehicle exists with id: " + std::to_string(id));
+        }
+        station->removeCar(id);
+    }
+    if (scenario.platforms > 0) {
+        for (auto& station: fleet) {
+            station.setPlatformCount(scenario.platforms);
+        }
+    }
+    return fleet;
+}
+
+//
+// Non-members
+//
+
+void writeCsv(std::ostream& os, const std::vector<ScenarioResult>& results)
+{
+    os << "scenario,total_departure_delay,total_arrival_delay,completed_trains\n";
+    for (const auto& [name, departureDelay, arrivalDelay, completed]: results) {
+        os << name << ','
+           << departureDelay.rawTime() << ','
+           << arrivalDelay.rawTime() << ','
+           << completed << '\n';
+    }
+}
+
+}  // namespace pabo::app
@@ -0,0 +1,144 @@
+/**
+    @file src/scope_trace.cpp
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief Implementation of the ScopeTrace class.
+
+    Only compiled when tracing is on, see scope_trace.h.
+*/
+
+#include "scope_trace.h"
+#include <algorithm>  // min
+#include <atomic>
+#include <chrono>
+#include <cstddef>  // size_t
+#include <iomanip>  // setprecision
+#include <iostream>
+#include <memory>  // make_shared, shared_ptr
+#include <mutex>
+#include <vector>
+
+namespace pabo {
+
+namespace {
+
+struct Record {
+    const char* name;
+    std::int64_t start;
+    std::int64_t duration;
+};
+
+// The records of one thread. Only the thread writes, the oldest
+// records are overwritten when the buffer is full.
+class ThreadBuffer {
+public:
+    explicit ThreadBuffer(int tid)
+        : m_records(capacity), m_tid{tid} {}
+
+    void push(const Record& r) noexcept
+    {
+        const auto n = m_written.load(std::memory_order_relaxed);
+        m_records[n & (capacity - 1)] = r;
+        m_written.store(n + 1, std::memory_order_release);
+    }
+
+    template<typename Function>
+    void forEach(Function f) const
+    {
+        const auto n = m_written.load(std::memory_order_acquire);
+        for (auto i = n - std::min(n, capacity); i < n; ++i) {
+            f(m_records[i & (capacity - 1)]);
+        }
+    }
+
+    void clear() noexcept { m_written.store(0, std::memory_order_release); }
+    [[nodiscard]] int tid() const noexcept { return m_tid; }
+
+private:
+    static constexpr std::size_t capacity{std::size_t{1} << 16};
+
+    std::vector<Record> m_records;
+    std::atomic<std::size_t> m_written{0};
+    int m_tid;
+};
+
+// The buffers are shared with the registry, so the records of a
+// thread that has exited are still exported.
+std::mutex s_registryMutex;
+std::vector<std::shared_ptr<ThreadBuffer>> s_registry;
+
+ThreadBuffer& threadBuffer()
+{
+    thread_local const auto buffer = [] {
+        const auto lock = std::scoped_lock{s_registryMutex};
+        const auto tid = static_cast<int>(s_registry.size()) + 1;
+        return s_registry.emplace_back(std::make_shared<ThreadBuffer>(tid));
+    }();
+    return *buffer;
+}
+
+std::int64_t nanosecondsSinceStart() noexcept
+{
+    using Clock = std::chrono::steady_clock;
+    static const auto start = Clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+}
+
+void writeName(std::ostream& os, const char* name)
+{
+    os << '"';
+    for (auto c = name; *c != '\0'; ++c) {
+        if (*c == '"' || *c == '\\') {
+            os << '\\';
+        }
+        os << *c;
+    }
+    os << '"';
+}
+
+}  // namespace
+
+ScopeTrace::ScopeTrace(const char* name) noexcept
+    : m_name{name}, m_start{nanosecondsSinceStart()}
+{
+}
+
+ScopeTrace::~ScopeTrace()
+{
+    threadBuffer().push({m_name, m_start, nanosecondsSinceStart() - m_start});
+}
+
+void writeScopeTraces(std::ostream& os)
+{
+    const auto lock = std::scoped_lock{s_registryMutex};
+    const auto flags = os.flags();
+    const auto precision = os.precision();
+    os << std::fixed << std::setprecision(3);
+    os << "{\"traceEvents\":[";
+    auto first = true;
+    for (const auto& buffer: s_registry) {
+        buffer->forEach([&](const Record& r) {
+            os << (first ? "\n" : ",\n") << "{\"name\":";
+            writeName(os, r.name);
+            // Chrome traces count in microseconds.
+            os << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->tid()
+               << ",\"ts\":" << static_cast<double>(r.start) / 1000.0
+               << ",\"dur\":" << static_cast<double>(r.duration) / 1000.0 << '}';
+            first = false;
+        });
+    }
+    os << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    os.flags(flags);
+    os.precision(precision);
+}
+
+void clearScopeTraces() noexcept
+{
+    const auto lock = std::scoped_lock{s_registryMutex};
+    for (const auto& buffer: s_registry) {
+        buffer->clear();
+    }
+}
+
+}  // namespace pabo
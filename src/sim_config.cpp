@@ -0,0 +1,32 @@
+/**
+    @file src/sim_config.cpp
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief Implementation of the SimConfig struct.
+*/
+
+#include "sim_config.h"
+#include <stdexcept>  // invalid_argument
+
+namespace pabo::train {
+
+void SimConfig::validate() const
+{
+    // A new attempt at the same time as the failed one would never
+    // let the clock advance.
+    if (timeBetweenAssemblyAttempts.rawTime() <= 0) {
+        throw std::invalid_argument("Time between assembly attempts must be positive!");
+    }
+    if (!allocation) {
+        throw std::invalid_argument("No car allocation policy!");
+    }
+    if (repositioning && !(repositioningSpeed > 0.0)) {
+        throw std::invalid_argument("Repositioning speed must be positive!");
+    }
+    if (tracksPerPath < 0) {
+        throw std::invalid_argument("Tracks per path can not be negative!");
+    }
+}
+
+}  // namespace pabo::train
@@ -1,8 +1,18 @@
+#include "car_log.h"
 #include "event.h"
+#include "event_batch.h"
+#include "scope_trace.h"
 #include "simulator.h"
+#include "station_partitions.h"
+#include "thread_pool.h"
 #include "time_point.h"
+#include "time_warp.h"
 #include "train_dispatcher.h"
+#include "train_log.h"
+#include <algorithm>  // max
 #include <memory>
+#include <ostream>
+#include <stdexcept>  // out_of_range
 #include <string>
 #include <utility>  // move
 
@@ -15,6 +25,8 @@ Sim::Simulator(train::TrainDispatcher& disp, TrainLog& log, CarLog& cl)
 {
 }
 
+Sim::~Simulator() = default;
+
 auto Sim::nextEvent() const
 {
     return m_queue.top();
@@ -22,6 +34,7 @@ auto Sim::nextEvent() const
 
 void Sim::reset()
 {
+    PABO_TRACE_SCOPE("Simulator::reset");
     clearEvents();
     m_highPriorityEvents = 0;
     m_clock = m_start;
@@ -85,13 +98,70 @@ void Sim::setInterval(int minutes)
     m_interval = time::TimeOfDay(minutes);
 }
 
+const SimConfig& Sim::config() const noexcept
+{
+    return m_config;
+}
+
+void Sim::setConfig(SimConfig config)
+{
+    config.validate();
+    m_config = std::move(config);
+}
+
+Sim::Execution Sim::execution() const noexcept
+{
+    return m_execution;
+}
+
+void Sim::setExecution(Execution e) noexcept
+{
+    m_execution = e;
+}
+
+Sim::Duration Sim::optimisticWindow() const noexcept
+{
+    return m_optimisticWindow;
+}
+
+void Sim::setOptimisticWindow(Duration window)
+{
+    if (window < Duration{1}) {
+        throw std::out_of_range("The optimistic window must be positive!");
+    }
+    m_optimisticWindow = window;
+}
+
+void Sim::addObserver(EventObserver& observer)
+{
+    m_hooks.add(observer);
+}
+
+void Sim::removeObserver(const EventObserver& observer) noexcept
+{
+    m_hooks.remove(observer);
+}
+
 void Sim::scheduleEvent(std::shared_ptr<train::Event> e)
 {
     bool highPriority = e->isHighPriority();
+    if (!(e->time() < endTime()) && !highPriority) {
+        return;
+    }
     if (highPriority) {
         ++m_highPriorityEvents;
     }
-    if ((e->time() < endTime()) || highPriority) {
+    m_hooks.schedule(*e);
+    if (m_batch) {
+        m_batch->schedule(std::move(e));
+    }
+    else if (m_partitions) {
+        m_partitions->schedule(std::move(e));
+    }
+    else if (m_timeWarp) {
+        m_timeWarp->schedule(std::move(e));
+    }
+    else {
         m_queue.emplace(std::move(e));
     }
 }
@@ -109,13 +179,26 @@ bool Sim::timeIsUp() const
 
 void Sim::runNextEvent()
 {
+    PABO_TRACE_SCOPE("Simulator::runNextEvent");
+    if (!m_queue.empty()) {
+        processNextEvent();
+    }
+    if (m_queue.empty()) {
+        stopWhenIdle();
+    }
+}
+
+void Sim::processNextEvent()
+{
+    // Pop before processing, the event may schedule new events that
+    // end up on top of the queue.
     auto event = nextEvent();
+    m_queue.pop();
     syncClockWithEvent(*event);
-    event->processEvent(m_log, m_carLog);
+    m_hooks.process(*event, m_log, m_carLog);
     if (event->isHighPriority()) {
         --m_highPriorityEvents;
     }
-    m_queue.pop();
 }
 
 void Sim::syncClockWithEvent(const train::Event& event)
@@ -125,23 +208,28 @@ void Sim::syncClockWithEvent(const train::Event& event)
 
 void Sim::runTo(const Duration& end)
 {
-    while (nextEvent()->time() < end) {
-        runNextEvent();
+    while (!m_queue.empty() && nextEvent()->time() < end) {
+        processNextEvent();
     }
     m_clock = end;
+    if (m_queue.empty()) {
+        stopWhenIdle();
+    }
 }
 
 void Sim::runNextInterval()
 {
+    PABO_TRACE_SCOPE("Simulator::runNextInterval");
     const auto stopTime = nextStopTime();
     runTo(stopTime);
 }
 
 void Sim::runToCompletion()
 {
-    while (!isFinished()) {
-        runNextEvent();
+    while (!isFinished() && !m_queue.empty()) {
+        processNextEvent();
     }
+    settleWaitingTrains();
     // the clock can run past the set endtime, so only set it
     // if needed.
     if (m_clock < endTime()) {
@@ -149,4 +237,199 @@ void Sim::runToCompletion()
     }
 }
 
+void Sim::runToCompletion(ThreadPool& pool)
+{
+    PABO_TRACE_SCOPE("Simulator::runToCompletion");
+    // The empty car moves belong to no station, and the tracks are
+    // shared by the stations, so the stations can not run on their own.
+    if (m_config.repositioning || m_config.tracksPerPath > 0) {
+        runToCompletion();
+        return;
+    }
+    switch (m_execution) {
+    case Execution::sequential:
+        runToCompletion();
+        break;
+    case Execution::batched:
+        runBatched(pool);
+        break;
+    case Execution::conservative:
+        runConservatively(pool);
+        break;
+    case Execution::optimistic:
+        // A rollback would leave the policy with choices that were
+        // based on undone events.
+        if (m_config.allocation->supportsRollback()) {
+            runOptimistically(pool);
+        }
+        else {
+            runConservatively(pool);
+        }
+        break;
+    }
+    settleWaitingTrains();
+}
+
+void Sim::stopWhenIdle()
+{
+    // Nothing is left to happen before the end time.
+    settleWaitingTrains();
+    if (m_clock < endTime()) {
+        m_clock = endTime();
+    }
+}
+
+void Sim::settleWaitingTrains()
+{
+    const auto retry = m_config.timeBetweenAssemblyAttempts.rawTime();
+    for (const auto& w: m_dispatch.takeWaitingTrains()) {
+        if (w.nextAttempt < m_end) {
+            const auto attempts = (m_end.rawTime() - w.nextAttempt.rawTime() + retry - 1) / retry;
+            m_dispatch.delayDeparture(w.trainNbr, Duration{attempts * retry});
+        }
+    }
+    // A train still waiting for a platform waits until the end.
+    for (const auto& w: m_dispatch.takePlatformWaiters()) {
+        if (w.since < m_end.rawTime()) {
+            const auto wait = Duration{m_end.rawTime() - w.since};
+            if (m_dispatch.viewTrain(w.trainNbr).hasDeparted()) {
+                m_dispatch.delayArrival(w.trainNbr, wait);
+            }
+            else {
+                m_dispatch.delayDeparture(w.trainNbr, wait);
+            }
+        }
+    }
+}
+
+void Sim::runStartEvents()
+{
+    // Events that belong to no station, the start event, are run
+    // first since they schedule the events of the trains.
+    while (!isFinished() && !m_queue.empty() &&
+           nextEvent()->site() == train::Site::none) {
+        processNextEvent();
+    }
+}
+
+void Sim::runBatched(ThreadPool& pool)
+{
+    runStartEvents();
+
+    // Without travel time an arrival could join the batch of its
+    // departure at another station.
+    if (m_dispatch.minimumTravelTime() < Duration{1}) {
+        runToCompletion();
+        return;
+    }
+
+    auto batch = std::make_unique<EventBatch>(m_dispatch, m_hooks);
+    while (!isFinished() && !m_queue.empty()) {
+        const auto time = nextEvent()->time();
+        for (; !m_queue.empty() && nextEvent()->time() == time; m_queue.pop()) {
+            batch->add(nextEvent());
+        }
+        m_clock = time;
+
+        m_batch = std::move(batch);
+        try {
+            m_batch->run(pool, m_log, m_carLog);
+        }
+        catch (...) {
+            m_batch.reset();
+            throw;
+        }
+        batch = std::move(m_batch);
+
+        m_highPriorityEvents -= batch->takeHighPriorityCount();
+        for (auto& e: batch->takeScheduled()) {
+            m_queue.emplace(std::move(e));
+        }
+    }
+
+    if (m_clock < endTime()) {
+        m_clock = endTime();
+    }
+}
+
+void Sim::runConservatively(ThreadPool& pool)
+{
+    runStartEvents();
+
+    // Without a lookahead every window would be empty.
+    const auto lookahead = m_dispatch.minimumTravelTime();
+    if (lookahead < Duration{1}) {
+        runToCompletion();
+        return;
+    }
+
+    m_partitions = std::make_unique<StationPartitions>(m_dispatch, m_hooks);
+    try {
+        for (; !m_queue.empty(); m_queue.pop()) {
+            m_partitions->schedule(m_queue.top());
+        }
+        for (auto next = m_partitions->nextEventTime(); next && !isFinished();
+             next = m_partitions->nextEventTime()) {
+            m_partitions->runWindow(pool, *next + lookahead);
+            m_partitions->mergeLogs(m_log, m_carLog);
+            m_highPriorityEvents -= m_partitions->takeHighPriorityCount();
+            m_clock = std::max(m_clock, m_partitions->lastEventTime());
+        }
+    }
+    catch (...) {
+        m_partitions.reset();
+        throw;
+    }
+    m_partitions.reset();
+
+    if (m_clock < endTime()) {
+        m_clock = endTime();
+    }
+}
+
+void Sim::runOptimistically(ThreadPool& pool)
+{
+    runStartEvents();
+
+    m_timeWarp = std::make_unique<TimeWarp>(m_dispatch, m_hooks, m_optimisticWindow);
+    try {
+        for (; !m_queue.empty(); m_queue.pop()) {
+            m_timeWarp->schedule(m_queue.top());
+        }
+        // Stopping early is only a shortcut in the sequential mode, the
+        // remaining events never make a difference.
+        while (m_timeWarp->hasPendingEvents()) {
+            m_timeWarp->runRound(pool);
+            m_timeWarp->mergeLogs(m_log, m_carLog);
+        }
+    }
+    catch (...) {
+        m_timeWarp.reset();
+        throw;
+    }
+    m_clock = std::max(m_clock, m_timeWarp->lastEventTime());
+    m_timeWarp.reset();
+    // Every scheduled event has been processed or cancelled.
+    m_highPriorityEvents = 0;
+
+    if (m_clock < endTime()) {
+        m_clock = endTime();
+    }
+}
+
+std::ostream& operator<<(std::ostream& os, Simulator::Execution e)
+{
+    switch (e) {
+    case Simulator::Execution::sequential:
+        return os << "sequential";
+    case Simulator::Execution::batched:
+        return os << "batched parallel";
+    case Simulator::Execution::conservative:
+        return os << "conservative parallel";
+    case Simulator::Execution::optimistic:
+        return os << "optimistic parallel";
+    }
+    return os;
+}
+
 }  // namespace pabo::app
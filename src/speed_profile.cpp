@@ -0,0 +1,92 @@
+/**
+    @file src/speed_profile.cpp
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief Implementation of the SpeedProfile class.
+*/
+
+#include "speed_profile.h"
+#include <algorithm>  // lower_bound, min, sort
+#include <cmath>  // isinf
+#include <cstddef>  // size_t
+#include <stdexcept>  // invalid_argument
+#include <vector>
+
+namespace pabo::train {
+
+namespace {
+constexpr auto tolerance = 1e-9;
+}  // namespace
+
+SpeedProfile::SpeedProfile(const std::vector<Segment>& segments)
+{
+    auto limited = std::vector<Segment>{};
+    for (const auto& s: segments) {
+        if (s.speedLimit <= 0.0) {
+            throw std::invalid_argument("A speed limit must be positive!");
+        }
+        m_distance += s.distance;
+        if (!std::isinf(s.speedLimit)) {
+            limited.push_back(s);
+        }
+    }
+    std::sort(limited.begin(), limited.end(), [](const Segment& lhs, const Segment& rhs) {
+        return lhs.speedLimit < rhs.speedLimit;
+    });
+
+    for (const auto& s: limited) {
+        if (m_limits.empty() || m_limits.back() < s.speedLimit) {
+            m_limits.push_back(s.speedLimit);
+            m_slowDistance.push_back(m_slowDistance.back());
+            m_slowHours.push_back(m_slowHours.back());
+        }
+        m_slowDistance.back() += s.distance;
+        m_slowHours.back() += s.distance / s.speedLimit;
+    }
+}
+
+SpeedProfile::Distance SpeedProfile::distance() const
+{
+    return {m_distance, "km"};
+}
+
+SpeedProfile::Duration SpeedProfile::travelTime(const Speed& speed) const
+{
+    // The paths with a limit below the speed are run at their limit.
+    const auto slow = static_cast<std::size_t>(
+            std::lower_bound(m_limits.begin(), m_limits.end(), speed.value) -
+            m_limits.begin());
+    const auto fast = m_distance - m_slowDistance[slow];
+    return Duration{(fast / speed.value + m_slowHours[slow]) * 60.0};
+}
+
+SpeedProfile::Speed SpeedProfile::speedFor(const Duration& travelTime) const
+{
+    // The travel time only falls with the speed, so the speed is the
+    // first one that is not above the limit of the next path to slow
+    // down on.
+    const auto hours = travelTime.inHours();
+    for (auto slow = std::size_t{0}; slow <= m_limits.size(); ++slow) {
+        if (hours <= m_slowHours[slow]) {
+            break;
+        }
+        const auto fast = m_distance - m_slowDistance[slow];
+        if (slow == m_limits.size() && slow > 0 && fast <= 0.0) {
+            // Every path is limited, no speed above the highest limit helps.
+            return {m_limits.back(), "kph"};
+        }
+        const auto speed = fast / (hours - m_slowHours[slow]);
+        if (slow == m_limits.size()) {
+            return {speed, "kph"};
+        }
+        // A travel time that is run exactly at a limit may come out a
+        // rounding error above it.
+        if (speed <= m_limits[slow] * (1.0 + tolerance)) {
+            return {std::min(speed, m_limits[slow]), "kph"};
+        }
+    }
+    throw std::invalid_argument("The speed limits do not allow the travel time!");
+}
+
+}  // namespace pabo::train
@@ -9,7 +9,7 @@
 #include "station.h"
 #include "string_funcs.h"  // replaceCharWithSpace
 #include "vehicle_factory.h"  // makeVehicle
-#include <algorithm>  // any_of, find_if
+#include <algorithm>  // any_of, count_if, find_if, remove_if
 #include <iterator>  // begin, end
 #include <sstream>  // istringstream
 #include <stdexcept>
@@ -25,14 +25,19 @@ Station::Car makeCarFromString(std::string);
 std::pair<Station::CarType, Params> paramsFromString(const std::string& s);
 
 Station::Station(std::string name)
-    : m_name{std::move(name)}
 {
-    trimWhitespace(m_name);
+    trimWhitespace(name);
+    m_id = internStation(name);
 }
 
-std::string Station::name() const
+StationId Station::id() const noexcept
 {
-    return m_name;
+    return m_id;
+}
+
+std::string_view Station::name() const
+{
+    return stationName(m_id);
 }
 
 bool Station::hasCar(CarType t) const
@@ -52,6 +57,12 @@ int Station::carCount() const noexcept
     return static_cast<int>(m_self.size());
 }
 
+int Station::carCount(CarType t) const
+{
+    const auto isType = IsType(t);
+    return static_cast<int>(std::count_if(m_self.begin(), m_self.end(), isType));
+}
+
 bool Station::isEmpty() const noexcept
 {
     return m_self.empty();
@@ -64,7 +75,7 @@ Station::CarView Station::viewCar(const int id) const
     const auto hasId = HasId(id);
      const auto car = std::find_if(begin(m_self), end(m_self), hasId);
      if (car == m_self.end()) {
-         throw std::out_of_range("No such vehicle in " + m_name + std::to_string(id));
+         throw std::out_of_range("No such vehicle in " + std::string{name()} + std::to_string(id));
      }
      return car->get();
 }
@@ -78,6 +89,30 @@ std::vector<Station::CarView> Station::availableCars() const
     return res;
 }
 
+std::vector<Station::CarView> Station::availableCars(CarType t) const
+{
+    const auto isType = IsType(t);
+    auto res = std::vector<CarView>{};
+    for (const auto& car: m_self) {
+        if (isType(car)) {
+            res.push_back(car.get());
+        }
+    }
+    return res;
+}
+
+Station::CarView Station::firstCar(CarType t) const
+{
+    const auto isType = IsType(t);
+    const auto car = std::find_if(m_self.begin(), m_self.end(), isType);
+    return car == m_self.end() ? nullptr : car->get();
+}
+
+const PlatformOccupancy& Station::platforms() const noexcept
+{
+    return m_platforms;
+}
+
 void Station::addCar(Car car)
 {
     // The simulation data is static so asserting in debug mode is
@@ -103,6 +138,112 @@ Station::Car Station::getCar(CarType t)
     return res;
 }
 
+Station::Car Station::getCar(const int id)
+{
+    const auto hasId = HasId(id);
+    const auto car = std::find_if(m_self.begin(), m_self.end(), hasId);
+    if (car == m_self.end()) {
+        throw std::out_of_range("No such vehicle in " + std::string{name()} + ": " + std::to_string(id));
+    }
+    auto res = std::move(*car);
+    remove(car);
+    return res;
+}
+
+void Station::removeCar(const int id)
+{
+    const auto hasId = HasId(id);
+    const auto car = std::find_if(m_self.begin(), m_self.end(), hasId);
+    if (car == m_self.end()) {
+        throw std::out_of_range("No such vehicle in " + std::string{name()} + ": " + std::to_string(id));
+    }
+    remove(car);
+}
+
+void Station::addWaiter(const Waiter& w, const std::vector<CarType>& types)
+{
+    for (const auto type: types) {
+        auto& waitlist = m_waitlists[indexOf(type)];
+        const auto waiting = std::any_of(waitlist.begin(), waitlist.end(),
+                                         [&w](const Waiter& other) {
+                                             return other.trainNbr == w.trainNbr;
+                                         });
+        if (!waiting) {
+            waitlist.push_back(w);
+        }
+    }
+}
+
+std::vector<Station::Waiter> Station::wakeWaiters(const std::function<bool(const Waiter&)>& accept)
+{
+    auto res = std::vector<Waiter>{};
+    for (const auto type: vehicleTypes) {
+        if (m_waitlists[indexOf(type)].empty() || !hasCar(type)) {
+            continue;
+        }
+        // Copied, removing a waiter changes the list.
+        const auto waitlist = m_waitlists[indexOf(type)];
+        for (const auto& w: waitlist) {
+            if (accept(w)) {
+                removeWaiter(w.trainNbr);
+                res.push_back(w);
+            }
+        }
+    }
+    return res;
+}
+
+std::vector<Station::Waiter> Station::takeWaiters()
+{
+    auto res = std::vector<Waiter>{};
+    for (const auto type: vehicleTypes) {
+        for (const auto& w: m_waitlists[indexOf(type)]) {
+            const auto taken = std::any_of(res.begin(), res.end(),
+                                           [&w](const Waiter& other) {
+                                               return other.trainNbr == w.trainNbr;
+                                           });
+            if (!taken) {
+                res.push_back(w);
+            }
+        }
+        m_waitlists[indexOf(type)].clear();
+    }
+    return res;
+}
+
+void Station::setPlatformCount(const int platforms)
+{
+    m_platforms = PlatformOccupancy{platforms};
+}
+
+bool Station::takePlatform(const time::TimeOfDay time, const int trainNbr)
+{
+    return m_platforms.take(time.rawTime(), trainNbr);
+}
+
+std::optional<PlatformOccupancy::Waiter> Station::leavePlatform(
+        const time::TimeOfDay time,
+        const std::function<bool(const PlatformOccupancy::Waiter&)>& accept)
+{
+    return m_platforms.leave(time.rawTime(), accept);
+}
+
+std::vector<PlatformOccupancy::Waiter> Station::takePlatformWaiters()
+{
+    return m_platforms.takeWaiters();
+}
+
+void Station::removeWaiter(const int trainNbr)
+{
+    for (auto& waitlist: m_waitlists) {
+        waitlist.erase(std::remove_if(waitlist.begin(), waitlist.end(),
+                                      [trainNbr](const Waiter& w) {
+                                          return w.trainNbr == trainNbr;
+                                      }),
+                       waitlist.end());
+    }
+}
+
 void Station::remove(std::vector<Car>::iterator car)
 {
     m_self.erase(car);
@@ -126,10 +267,21 @@ std::istream& operator>>(std::istream& is, Station& station)
     }
 
     auto iss = std::istringstream{line};
+    auto header = std::string{};
+    std::getline(iss, header, '(');
+
+    // The name may be followed by the number of platforms.
+    auto headerStream = std::istringstream{header};
     auto stationName = std::string{};
-    std::getline(iss, stationName, '(');
+    headerStream >> stationName;
+    auto platforms = 0;
+    if (!(headerStream >> platforms) && !headerStream.eof()) {
+        is.setstate(std::ios::failbit);
+        return is;
+    }
 
     auto tmp = Station{stationName};
+    tmp.setPlatformCount(platforms);
     addCarsFromStream(iss, tmp);
 
     using std::swap;
@@ -0,0 +1,72 @@
+/**
+    @file src/station_id.cpp
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief Implementation of the interned station names.
+*/
+
+#include "station_id.h"
+#include <deque>
+#include <limits>  // numeric_limits
+#include <mutex>  // lock_guard, mutex
+#include <stdexcept>  // length_error, out_of_range
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace pabo::train {
+
+namespace {
+
+// A deque never moves its elements, so the views stay valid as the
+// table grows.
+struct StationTable {
+    StationTable() { intern(""); }
+
+    StationId intern(std::string_view name)
+    {
+        const auto found = ids.find(name);
+        if (found != ids.end()) {
+            return found->second;
+        }
+        if (names.size() > std::numeric_limits<StationId>::max()) {
+            throw std::length_error("Too many station names!");
+        }
+        const auto id = static_cast<StationId>(names.size());
+        const auto& stored = names.emplace_back(name);
+        ids.emplace(stored, id);
+        return id;
+    }
+
+    std::mutex mutex;
+    std::deque<std::string> names;
+    std::unordered_map<std::string_view, StationId> ids;
+};
+
+StationTable& table()
+{
+    static auto instance = StationTable{};
+    return instance;
+}
+
+}  // namespace
+
+StationId internStation(std::string_view name)
+{
+    auto& t = table();
+    const auto lock = std::lock_guard{t.mutex};
+    return t.intern(name);
+}
+
+std::string_view stationName(const StationId id)
+{
+    auto& t = table();
+    const auto lock = std::lock_guard{t.mutex};
+    if (id >= t.names.size()) {
+        throw std::out_of_range("No station with id: " + std::to_string(id));
+    }
+    return t.names[id];
+}
+
+}  // namespace pabo::train
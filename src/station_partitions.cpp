@@ -0,0 +1,128 @@
+/**
+    @file src/station_partitions.cpp
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief Implementation of the StationPartitions class.
+*/
+
+#include "station_partitions.h"
+#include "thread_pool.h"
+#include "train_dispatcher.h"
+#include <algorithm>  // max, min
+#include <stdexcept>  // logic_error
+#include <string>
+#include <utility>  // move
+
+namespace pabo::app {
+
+namespace {
+// The partition that the current thread is processing, if any.
+thread_local const void* currentPartition{nullptr};
+}  // namespace
+
+StationPartitions::StationPartitions(const train::TrainDispatcher& disp,
+                                     const EventHooks& hooks)
+    : m_hooks{hooks}, m_sites{disp}
+{
+    for (auto i = std::size_t{0}; i < m_sites.stationCount(); ++i) {
+        m_partitions.emplace_back(std::make_unique<Partition>());
+    }
+}
+
+auto StationPartitions::partitionOf(const train::Event& event) -> Partition&
+{
+    return *m_partitions[m_sites.stationOf(event)];
+}
+
+void StationPartitions::schedule(EventPtr event)
+{
+    auto& p = partitionOf(*event);
+    if (currentPartition != &p && event->time() < m_windowEnd) {
+        throw std::logic_error("Event for train " + std::to_string(event->trainNbr()) +
+                               " scheduled within the lookahead of another station!");
+    }
+    auto lock = std::lock_guard{p.inboxMutex};
+    p.inbox.emplace_back(std::move(event));
+}
+
+void StationPartitions::deliver(Partition& p)
+{
+    auto lock = std::lock_guard{p.inboxMutex};
+    for (auto& event: p.inbox) {
+        p.queue.emplace(std::move(event));
+    }
+    p.inbox.clear();
+}
+
+std::optional<time::TimeOfDay> StationPartitions::nextEventTime()
+{
+    auto res = std::optional<time::TimeOfDay>{};
+    for (auto& p: m_partitions) {
+        deliver(*p);
+        if (p->queue.empty()) { continue; }
+        const auto time = p->queue.top()->time();
+        res = res ? std::min(*res, time) : time;
+    }
+    return res;
+}
+
+void StationPartitions::runWindow(ThreadPool& pool, time::TimeOfDay windowEnd)
+{
+    m_windowEnd = windowEnd;
+    pool.parallelFor(m_partitions.size(), [this](std::size_t i) {
+        runPartition(*m_partitions[i]);
+    });
+}
+
+void StationPartitions::runPartition(Partition& p)
+{
+    currentPartition = &p;
+    for (deliver(p); !p.queue.empty(); deliver(p)) {
+        if (p.queue.top()->time() >= m_windowEnd) {
+            break;
+        }
+        auto event = p.queue.top();
+        p.queue.pop();
+        p.lastEventTime = std::max(p.lastEventTime, event->time());
+        m_hooks.process(*event, p.log, p.carLog);
+        if (event->isHighPriority()) {
+            ++p.highPriorityCount;
+        }
+    }
+    currentPartition = nullptr;
+}
+
+time::TimeOfDay StationPartitions::lastEventTime() const
+{
+    auto res = time::TimeOfDay{0};
+    for (const auto& p: m_partitions) {
+        res = std::max(res, p->lastEventTime);
+    }
+    return res;
+}
+
+int StationPartitions::takeHighPriorityCount()
+{
+    auto res = 0;
+    for (auto& p: m_partitions) {
+        res += p->highPriorityCount;
+        p->highPriorityCount = 0;
+    }
+    return res;
+}
+
+void StationPartitions::mergeLogs(train::TrainLog& log, train::CarLog& carLog)
+{
+    // Merged into one log first, the records are then an append to the log.
+    auto merged = train::TrainLog{};
+    for (auto& p: m_partitions) {
+        merged.merge(std::move(p->log));
+        carLog.merge(std::move(p->carLog));
+        p->log = train::TrainLog{};
+        p->carLog = train::CarLog{};
+    }
+    log.merge(std::move(merged));
+}
+
+}  // namespace pabo::app
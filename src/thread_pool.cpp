@@ -0,0 +1,113 @@
+/**
+    @file src/thread_pool.cpp
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief Implementation of the ThreadPool class.
+*/
+
+#include "thread_pool.h"
+#include <algorithm>  // max
+#include <utility>  // swap
+
+namespace pabo::app {
+
+ThreadPool::ThreadPool(unsigned size)
+{
+    if (size == 0) {
+        size = std::max(1U, std::thread::hardware_concurrency());
+    }
+    m_workers.reserve(size - 1);
+    for (auto i = 1U; i < size; ++i) {
+        m_workers.emplace_back([this] { work(); });
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        auto lock = std::lock_guard{m_mutex};
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    for (auto& worker: m_workers) {
+        worker.join();
+    }
+}
+
+unsigned ThreadPool::size() const noexcept
+{
+    return static_cast<unsigned>(m_workers.size()) + 1;
+}
+
+void ThreadPool::parallelFor(const std::size_t count, const Task& task)
+{
+    if (m_workers.empty() || count < 2) {
+        for (auto i = std::size_t{0}; i < count; ++i) {
+            task(i);
+        }
+        return;
+    }
+
+    {
+        auto lock = std::lock_guard{m_mutex};
+        m_task = &task;
+        m_count = count;
+        m_next = 0;
+        m_busy = m_workers.size();
+        m_error = nullptr;
+        ++m_generation;
+    }
+    m_wake.notify_all();
+    runTasks();
+
+    auto lock = std::unique_lock{m_mutex};
+    m_done.wait(lock, [this] { return m_busy == 0; });
+    m_task = nullptr;
+    auto error = std::exception_ptr{};
+    using std::swap;
+    swap(error, m_error);
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+void ThreadPool::work()
+{
+    auto seen = std::uint64_t{0};
+    for (;;) {
+        {
+            auto lock = std::unique_lock{m_mutex};
+            m_wake.wait(lock, [this, seen] {
+                return m_stopping || m_generation != seen;
+            });
+            if (m_stopping) {
+                return;
+            }
+            seen = m_generation;
+        }
+        runTasks();
+
+        auto lock = std::lock_guard{m_mutex};
+        if (--m_busy == 0) {
+            m_done.notify_one();
+        }
+    }
+}
+
+void ThreadPool::runTasks()
+{
+    for (auto i = m_next++; i < m_count; i = m_next++) {
+        try {
+            (*m_task)(i);
+        }
+        catch (...) {
+            auto lock = std::lock_guard{m_mutex};
+            if (!m_error) {
+                m_error = std::current_exception();
+            }
+        }
+    }
+}
+
+}  // namespace pabo::app
@@ -0,0 +1,248 @@
+/**
+    @file src/time_warp.cpp
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief Implementation of the TimeWarp class.
+*/
+
+#include "thread_pool.h"
+#include "time_warp.h"
+#include "train_dispatcher.h"
+#include <algorithm>  // any_of, find_if, max
+#include <functional>  // less
+#include <iterator>  // begin, end
+#include <utility>  // move
+
+namespace pabo::app {
+
+thread_local TimeWarp::Partition* TimeWarp::s_currentPartition{nullptr};
+thread_local TimeWarp::Record* TimeWarp::s_currentRecord{nullptr};
+
+bool TimeWarp::EventOrder::operator()(const EventPtr& lhs, const EventPtr& rhs) const
+{
+    if (lhs->time() != rhs->time()) {
+        return lhs->time() < rhs->time();
+    }
+    if (lhs->trainNbr() != rhs->trainNbr()) {
+        return lhs->trainNbr() < rhs->trainNbr();
+    }
+    return std::less<>{}(lhs.get(), rhs.get());
+}
+
+TimeWarp::TimeWarp(train::TrainDispatcher& disp, const EventHooks& hooks,
+                   Duration window)
+    : m_disp{disp}, m_hooks{hooks}, m_sites{disp}, m_window{window}
+{
+    for (auto i = std::size_t{0}; i < m_sites.stationCount(); ++i) {
+        m_partitions.emplace_back(std::make_unique<Partition>());
+        m_partitions.back()->idx = i;
+    }
+}
+
+auto TimeWarp::partitionOf(const train::Event& event) -> Partition&
+{
+    return *m_partitions[m_sites.stationOf(event)];
+}
+
+void TimeWarp::schedule(EventPtr event)
+{
+    auto& p = partitionOf(*event);
+    if (s_currentRecord) {
+        s_currentRecord->children.push_back(event);
+    }
+    if (s_currentPartition == &p) {
+        p.pending.emplace(std::move(event));
+    }
+    else if (s_currentPartition) {
+        s_currentPartition->outbox.emplace_back(std::move(event));
+    }
+    else {
+        deliver(std::move(event));
+    }
+}
+
+bool TimeWarp::hasPendingEvents() const
+{
+    return std::any_of(m_partitions.begin(), m_partitions.end(),
+                       [](const auto& p) { return !p->pending.empty(); });
+}
+
+auto TimeWarp::globalVirtualTime() const -> std::optional<EventPtr>
+{
+    auto res = std::optional<EventPtr>{};
+    for (const auto& p: m_partitions) {
+        if (p->pending.empty()) { continue; }
+        const auto& first = *p->pending.begin();
+        if (!res || EventOrder{}(first, *res)) {
+            res = first;
+        }
+    }
+    return res;
+}
+
+void TimeWarp::runRound(ThreadPool& pool)
+{
+    const auto gvt = globalVirtualTime();
+    if (!gvt) { return; }
+    const auto horizon = (*gvt)->time() + m_window;
+    pool.parallelFor(m_partitions.size(), [this, horizon](std::size_t i) {
+        runPartition(*m_partitions[i], horizon);
+    });
+    exchangeMessages();
+
+    const auto next = globalVirtualTime();
+    for (auto& p: m_partitions) {
+        if (next) {
+            commit(*p, *next);
+        }
+        else {
+            while (!p->processed.empty()) {
+                commitFirst(*p);
+            }
+        }
+    }
+}
+
+void TimeWarp::runPartition(Partition& p, time::TimeOfDay horizon)
+{
+    s_currentPartition = &p;
+    const auto station = m_sites.station(p.idx);
+    while (!p.pending.empty() && (*p.pending.begin())->time() < horizon) {
+        auto event = *p.pending.begin();
+        p.pending.erase(p.pending.begin());
+
+        auto& record = p.processed.emplace_back(Record{
+                event, m_disp.saveStationState(station),
+                m_disp.saveTrainState(event->trainNbr()), {}, {}, {}});
+        s_currentRecord = &record;
+        m_hooks.process(*event, record.log, record.carLog);
+        s_currentRecord = nullptr;
+    }
+    s_currentPartition = nullptr;
+}
+
+void TimeWarp::exchangeMessages()
+{
+    auto messages = std::vector<EventPtr>{};
+    for (auto& p: m_partitions) {
+        messages.insert(messages.end(), p->outbox.begin(), p->outbox.end());
+        p->outbox.clear();
+    }
+    // Delivering a straggler can cancel messages later in the list.
+    for (auto& event: messages) {
+        if (m_cancelled.erase(event.get()) == 0) {
+            deliver(std::move(event));
+        }
+    }
+}
+
+void TimeWarp::deliver(EventPtr event)
+{
+    auto& p = partitionOf(*event);
+    rollback(p, *event);
+    p.pending.emplace(std::move(event));
+}
+
+void TimeWarp::rollback(Partition& p, const train::Event& straggler)
+{
+    const auto isLater = [&straggler](const Record& r) {
+        const auto& e = *r.event;
+        if (e.time() != straggler.time()) {
+            return straggler.time() < e.time();
+        }
+        return straggler.trainNbr() < e.trainNbr();
+    };
+    // An assembly that wraps around midnight schedules events before
+    // itself, so the processed events are not always in order and
+    // everything after the first later one is undone.
+    const auto kept = static_cast<std::size_t>(
+            std::find_if(p.processed.begin(), p.processed.end(), isLater) -
+            p.processed.begin());
+    while (p.processed.size() > kept) {
+        undoLast(p);
+    }
+}
+
+void TimeWarp::undoLast(Partition& p)
+{
+    auto record = std::move(p.processed.back());
+    p.processed.pop_back();
+    // The events scheduled by this event are always later, so they are
+    // undone before the states saved by this event are restored.
+    for (const auto& child: record.children) {
+        cancel(child);
+    }
+    m_disp.restoreStationState(std::move(record.station));
+    m_disp.restoreTrainState(std::move(record.train));
+    p.pending.emplace(std::move(record.event));
+    ++m_rolledBack;
+}
+
+void TimeWarp::cancel(const EventPtr& event)
+{
+    auto& p = partitionOf(*event);
+    if (p.pending.erase(event) > 0) {
+        return;
+    }
+    using std::begin;
+    using std::end;
+    const auto processed = std::find_if(begin(p.processed), end(p.processed),
+                                        [&event](const Record& r) {
+                                            return r.event == event;
+                                        });
+    if (processed == end(p.processed)) {
+        m_cancelled.insert(event.get());
+        return;
+    }
+    while (p.processed.back().event != event) {
+        undoLast(p);
+    }
+    undoLast(p);
+    p.pending.erase(event);
+}
+
+void TimeWarp::commit(Partition& p, const EventPtr& gvt)
+{
+    while (!p.processed.empty() && EventOrder{}(p.processed.front().event, gvt)) {
+        commitFirst(p);
+    }
+}
+
+void TimeWarp::commitFirst(Partition& p)
+{
+    auto& record = p.processed.front();
+    p.lastEventTime = std::max(p.lastEventTime, record.event->time());
+    p.log.merge(std::move(record.log));
+    p.carLog.merge(std::move(record.carLog));
+    p.processed.pop_front();
+}
+
+time::TimeOfDay TimeWarp::lastEventTime() const
+{
+    auto res = time::TimeOfDay{0};
+    for (const auto& p: m_partitions) {
+        res = std::max(res, p->lastEventTime);
+    }
+    return res;
+}
+
+std::size_t TimeWarp::rolledBackEvents() const noexcept
+{
+    return m_rolledBack;
+}
+
+void TimeWarp::mergeLogs(train::TrainLog& log, train::CarLog& carLog)
+{
+    // Merged into one log first, the records are then an append to the log.
+    auto merged = train::TrainLog{};
+    for (auto& p: m_partitions) {
+        merged.merge(std::move(p->log));
+        carLog.merge(std::move(p->carLog));
+        p->log = train::TrainLog{};
+        p->carLog = train::CarLog{};
+    }
+    log.merge(std::move(merged));
+}
+
+}  // namespace pabo::app
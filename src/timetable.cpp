@@ -0,0 +1,103 @@
+/**
+    @file src/timetable.cpp
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief Implementation of the Timetable class.
+*/
+
+#include "timetable.h"
+#include <algorithm>  // lower_bound, max, stable_sort
+#include <cstddef>  // size_t
+#include <vector>
+
+namespace pabo::train {
+
+Timetable::Timetable(const std::vector<TrainConnection>& connections)
+    : m_departures{makeIndex(
+              connections,
+              [](const TrainConnection& c) { return c.origin(); },
+              [](const TrainConnection& c) { return c.departure(); })}
+    , m_arrivals{makeIndex(
+              connections,
+              [](const TrainConnection& c) { return c.destination(); },
+              [](const TrainConnection& c) { return c.arrival(); })}
+{
+}
+
+Timetable::Entries Timetable::departuresFrom(const StationId id) const noexcept
+{
+    return all(m_departures, id);
+}
+
+Timetable::Entries Timetable::departuresFrom(const StationId id, const time::TimeOfDay from,
+                                             const time::TimeOfDay to) const
+{
+    return range(m_departures, id, from, to);
+}
+
+Timetable::Entries Timetable::arrivalsAt(const StationId id) const noexcept
+{
+    return all(m_arrivals, id);
+}
+
+Timetable::Entries Timetable::arrivalsAt(const StationId id, const time::TimeOfDay from,
+                                         const time::TimeOfDay to) const
+{
+    return range(m_arrivals, id, from, to);
+}
+
+template<typename StationOf, typename TimeOf>
+Timetable::Index Timetable::makeIndex(const std::vector<TrainConnection>& connections,
+                                      StationOf stationOf, TimeOf timeOf)
+{
+    // Counted per station first, so every connection is put in its
+    // place in the array directly.
+    auto stations = std::size_t{0};
+    for (const auto& c: connections) {
+        stations = std::max(stations, static_cast<std::size_t>(stationOf(c)) + 1);
+    }
+    auto res = Index{std::vector<Entry>(connections.size()),
+                     std::vector<std::size_t>(stations + 1)};
+    for (const auto& c: connections) {
+        ++res.first[stationOf(c) + 1];
+    }
+    for (auto i = std::size_t{1}; i < res.first.size(); ++i) {
+        res.first[i] += res.first[i - 1];
+    }
+    auto next = res.first;
+    for (auto i = std::size_t{0}; i < connections.size(); ++i) {
+        res.entries[next[stationOf(connections[i])]++] = {timeOf(connections[i]), i};
+    }
+    for (auto i = std::size_t{0}; i + 1 < res.first.size(); ++i) {
+        std::stable_sort(res.entries.begin() + static_cast<std::ptrdiff_t>(res.first[i]),
+                         res.entries.begin() + static_cast<std::ptrdiff_t>(res.first[i + 1]),
+                         [](const Entry& lhs, const Entry& rhs) {
+                             return lhs.scheduled < rhs.scheduled;
+                         });
+    }
+    return res;
+}
+
+Timetable::Entries Timetable::all(const Index& index, const StationId id) noexcept
+{
+    if (static_cast<std::size_t>(id) + 1 >= index.first.size()) {
+        return {};
+    }
+    const auto first = index.first[id];
+    return {index.entries.data() + first, index.first[id + 1] - first};
+}
+
+Timetable::Entries Timetable::range(const Index& index, const StationId id,
+                                    const time::TimeOfDay from, const time::TimeOfDay to)
+{
+    const auto station = all(index, id);
+    const auto before = [](const Entry& e, const time::TimeOfDay& t) {
+        return e.scheduled < t;
+    };
+    const auto first = std::lower_bound(station.begin(), station.end(), from, before);
+    const auto last = std::lower_bound(first, station.end(), to, before);
+    return {first, static_cast<std::size_t>(last - first)};
+}
+
+}  // namespace pabo::train
@@ -0,0 +1,195 @@
+/**
+    @file src/trace_reader.cpp
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief Implementation of the TraceReader class.
+*/
+
+#include "event_trace.h"
+#include "trace_reader.h"
+#include <algorithm>  // equal
+#include <cstring>  // memcpy
+#include <fcntl.h>  // open
+#include <iterator>  // begin, end
+#include <stdexcept>  // out_of_range, runtime_error
+#include <sys/mman.h>  // mmap, munmap
+#include <sys/stat.h>  // fstat
+#include <unistd.h>  // close
+#include <utility>  // exchange
+
+namespace pabo::train {
+
+namespace {
+
+template<typename T>
+T read(const char* data, std::size_t length, std::size_t& pos)
+{
+    if (pos + sizeof(T) > length) {
+        throw std::runtime_error("Truncated event trace!");
+    }
+    auto res = T{};
+    std::memcpy(&res, data + pos, sizeof(T));
+    pos += sizeof(T);
+    return res;
+}
+
+}  // namespace
+
+TraceReader::TraceReader(const std::string& filename)
+{
+    const auto fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Could not read " + filename);
+    }
+    struct stat info{};
+    if (::fstat(fd, &info) != 0 || info.st_size == 0) {
+        ::close(fd);
+        throw std::runtime_error("Not an event trace: " + filename);
+    }
+    m_length = static_cast<std::size_t>(info.st_size);
+    auto* data = ::mmap(nullptr, m_length, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        throw std::runtime_error("Could not map " + filename);
+    }
+    m_data = static_cast<const char*>(data);
+
+    try {
+        readHeader();
+    }
+    catch (...) {
+        unmap();
+        throw;
+    }
+}
+
+TraceReader::~TraceReader()
+{
+    unmap();
+}
+
+TraceReader::TraceReader(TraceReader&& other) noexcept
+    : m_data{std::exchange(other.m_data, nullptr)}
+    , m_length{std::exchange(other.m_length, 0)}
+    , m_stationNames{std::move(other.m_stationNames)}
+    , m_chunkRows{other.m_chunkRows}
+    , m_firstChunk{other.m_firstChunk}
+    , m_chunkCount{std::exchange(other.m_chunkCount, 0)}
+    , m_size{std::exchange(other.m_size, 0)}
+{
+}
+
+TraceReader& TraceReader::operator=(TraceReader&& other) noexcept
+{
+    if (this != &other) {
+        unmap();
+        m_data = std::exchange(other.m_data, nullptr);
+        m_length = std::exchange(other.m_length, 0);
+        m_stationNames = std::move(other.m_stationNames);
+        m_chunkRows = other.m_chunkRows;
+        m_firstChunk = other.m_firstChunk;
+        m_chunkCount = std::exchange(other.m_chunkCount, 0);
+        m_size = std::exchange(other.m_size, 0);
+    }
+    return *this;
+}
+
+void TraceReader::unmap() noexcept
+{
+    if (m_data) {
+        ::munmap(const_cast<char*>(m_data), m_length);
+        m_data = nullptr;
+    }
+}
+
+void TraceReader::readHeader()
+{
+    using std::begin;
+    using std::end;
+    if (m_length < sizeof(trace::magic) ||
+        !std::equal(begin(trace::magic), end(trace::magic), m_data)) {
+        throw std::runtime_error("Not an event trace!");
+    }
+    auto pos = sizeof(trace::magic);
+    if (read<std::uint32_t>(m_data, m_length, pos) != trace::version) {
+        throw std::runtime_error("Unsupported event trace version!");
+    }
+    m_chunkRows = read<std::uint32_t>(m_data, m_length, pos);
+    if (m_chunkRows == 0 || m_chunkRows % 8 != 0) {
+        throw std::runtime_error("Invalid chunk size in event trace!");
+    }
+    const auto stations = read<std::uint32_t>(m_data, m_length, pos);
+    for (auto i = std::uint32_t{0}; i < stations; ++i) {
+        const auto length = read<std::uint16_t>(m_data, m_length, pos);
+        if (pos + length > m_length) {
+            throw std::runtime_error("Truncated event trace!");
+        }
+        m_stationNames.emplace_back(m_data + pos, length);
+        pos += length;
+    }
+    m_firstChunk = (pos + 7) / 8 * 8;
+
+    const auto chunkSize = trace::chunkSize(m_chunkRows);
+    if (m_length < m_firstChunk || (m_length - m_firstChunk) % chunkSize != 0) {
+        throw std::runtime_error("Truncated event trace!");
+    }
+    m_chunkCount = (m_length - m_firstChunk) / chunkSize;
+    for (auto i = std::size_t{0}; i < m_chunkCount; ++i) {
+        auto countPos = m_firstChunk + i * chunkSize;
+        const auto count = read<std::uint32_t>(m_data, m_length, countPos);
+        if (count > m_chunkRows) {
+            throw std::runtime_error("Invalid chunk in event trace!");
+        }
+        m_size += count;
+    }
+}
+
+const std::vector<std::string>& TraceReader::stationNames() const noexcept
+{
+    return m_stationNames;
+}
+
+std::size_t TraceReader::size() const noexcept
+{
+    return m_size;
+}
+
+std::size_t TraceReader::chunkCount() const noexcept
+{
+    return m_chunkCount;
+}
+
+TraceReader::Chunk TraceReader::chunk(std::size_t idx) const
+{
+    if (idx >= m_chunkCount) {
+        throw std::out_of_range("No such chunk: " + std::to_string(idx));
+    }
+    const auto* base = m_data + m_firstChunk + idx * trace::chunkSize(m_chunkRows);
+    auto count = std::uint32_t{0};
+    std::memcpy(&count, base, sizeof(count));
+
+    // The columns are aligned since the chunks and the rows are.
+    const auto rows = m_chunkRows;
+    const auto* col = base + 8;
+    auto res = Chunk{};
+    res.size = count;
+    res.time = reinterpret_cast<const std::int32_t*>(col);
+    col += rows * sizeof(std::int32_t);
+    res.trainNbr = reinterpret_cast<const std::int32_t*>(col);
+    col += rows * sizeof(std::int32_t);
+    res.departureDelay = reinterpret_cast<const std::int32_t*>(col);
+    col += rows * sizeof(std::int32_t);
+    res.arrivalDelay = reinterpret_cast<const std::int32_t*>(col);
+    col += rows * sizeof(std::int32_t);
+    res.speed = reinterpret_cast<const float*>(col);
+    col += rows * sizeof(float);
+    res.station = reinterpret_cast<const std::uint16_t*>(col);
+    col += rows * sizeof(std::uint16_t);
+    res.type = reinterpret_cast<const std::uint8_t*>(col);
+    col += rows;
+    res.state = reinterpret_cast<const std::uint8_t*>(col);
+    return res;
+}
+
+}  // namespace pabo::train
@@ -0,0 +1,102 @@
+/**
+    @file src/track_occupancy.cpp
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief Implementation of the TrackOccupancy class.
+*/
+
+#include "track_occupancy.h"
+#include <algorithm>  // any_of, max, min
+#include <iterator>  // prev
+#include <limits>  // numeric_limits
+#include <stdexcept>  // invalid_argument, logic_error
+#include <string>
+#include <vector>
+
+namespace pabo::train {
+
+TrackOccupancy::TrackOccupancy(const int tracks)
+{
+    if (tracks < 1) {
+        throw std::invalid_argument("A path must have at least one track!");
+    }
+    m_tracks.resize(static_cast<std::size_t>(tracks));
+}
+
+int TrackOccupancy::tracks() const noexcept
+{
+    return static_cast<int>(m_tracks.size());
+}
+
+bool TrackOccupancy::isFree(const int begin, const int end) const
+{
+    return std::any_of(m_tracks.begin(), m_tracks.end(), [begin, end](const Track& t) {
+        return isFree(t, begin, end);
+    });
+}
+
+int TrackOccupancy::earliestFree(const int begin, const int length) const
+{
+    auto res = std::numeric_limits<int>::max();
+    for (const auto& track: m_tracks) {
+        res = std::min(res, earliestFree(track, begin, length));
+        if (res == begin) {
+            break;
+        }
+    }
+    return res;
+}
+
+void TrackOccupancy::reserve(const int begin, const int end, const int trainNbr)
+{
+    if (end <= begin) {
+        throw std::invalid_argument("A train must take a track for some time!");
+    }
+    for (auto& track: m_tracks) {
+        if (isFree(track, begin, end)) {
+            track.emplace(begin, Interval{end, trainNbr});
+            return;
+        }
+    }
+    throw std::logic_error("No free track for train " + std::to_string(trainNbr));
+}
+
+std::vector<int> TrackOccupancy::trainsAt(const int time) const
+{
+    auto res = std::vector<int>{};
+    for (const auto& track: m_tracks) {
+        // The last interval that starts at or before the time is the
+        // only one that can hold it.
+        const auto after = track.upper_bound(time);
+        if (after != track.begin() && std::prev(after)->second.end > time) {
+            res.push_back(std::prev(after)->second.trainNbr);
+        }
+    }
+    return res;
+}
+
+bool TrackOccupancy::isFree(const Track& track, const int begin, const int end)
+{
+    const auto after = track.lower_bound(begin);
+    if (after != track.end() && after->first < end) {
+        return false;
+    }
+    return after == track.begin() || std::prev(after)->second.end <= begin;
+}
+
+int TrackOccupancy::earliestFree(const Track& track, const int begin, const int length)
+{
+    // Walks the gaps after begin until one is long enough.
+    auto start = begin;
+    auto next = track.upper_bound(begin);
+    if (next != track.begin()) {
+        start = std::max(start, std::prev(next)->second.end);
+    }
+    for (; next != track.end() && next->first < start + length; ++next) {
+        start = std::max(start, next->second.end);
+    }
+    return start;
+}
+
+}  // namespace pabo::train
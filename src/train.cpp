@@ -4,7 +4,6 @@
 #include <stdexcept>
 #include <string>
 #include <utility>  // move
-#include <limits>
 
 namespace pabo::train {
 
@@ -41,7 +40,9 @@ Train::Train(const TrainConnection& tc)
 {
     for (const auto type: tc.vehicles()) {
         m_self.emplace_back(type, nullptr);
+        ++m_missing[indexOf(type)];
     }
+    m_missingTotal = static_cast<int>(m_self.size());
 }
 
 //
@@ -58,6 +59,11 @@ time::TimeOfDay Train::departure() const noexcept
     return m_departure;
 }
 
+Train::Duration Train::arrivalWait() const noexcept
+{
+    return m_arrivalWait;
+}
+
 Train::State Train::state() const noexcept
 {
     return m_state;
@@ -65,10 +71,7 @@ Train::State Train::state() const noexcept
 
 bool Train::isAssembled() const noexcept
 {
-    return std::none_of(m_self.begin(), m_self.end(), [](const Slot& s) {
-        const auto& [type, car] = s;
-        return !car;
-    });
+    return m_missingTotal == 0;
 }
 
 bool Train::hasDeparted() const noexcept
@@ -85,12 +88,14 @@ std::vector<Train::CarType> Train::missingCarTypes() const
     return res;
 }
 
-bool Train::missesCarOfType(CarType match) const
+int Train::missingCount(CarType type) const noexcept
+{
+    return m_missing[indexOf(type)];
+}
+
+bool Train::missesCarOfType(CarType match) const noexcept
 {
-    return std::any_of(m_self.begin(), m_self.end(),
-                       [match](const Slot& s) {
-                           return isEmptyAndType(s, match);
-                       });
+    return missingCount(match) > 0;
 }
 
 bool Train::hasCar(int id) const
@@ -110,10 +115,21 @@ void Train::delayDeparture(const int minutes)
     m_departure.addMinutes(minutes);
 }
 
+void Train::delayArrival(const int minutes)
+{
+    m_arrivalWait.addMinutes(minutes);
+}
+
 void Train::attachCar(Car c)
 {
     auto& [type, car] = findEmptySlotByType(c->type());
+    if (c->hasEngine() && (!m_hasEngine || c->maxSpeed() < m_maxSpd)) {
+        m_maxSpd = c->maxSpeed();
+        m_hasEngine = true;
+    }
     car = std::move(c);
+    --m_missing[indexOf(type)];
+    --m_missingTotal;
 }
 
 Train::Slot& Train::findEmptySlotByType(CarType match)
@@ -162,15 +178,7 @@ std::vector<Train::CarView> Train::attachedCars() const
 
 Train::Speed Train::maxSpeed() const
 {
-    const auto sentry = std::numeric_limits<double>::max();
-    auto res = Speed{sentry, "kph"};
-    for (const auto& [type, car] : m_self) {
-        if (car && car->hasEngine()) {
-            res = std::min(res, car->maxSpeed());
-        }
-    }
-    if (res == sentry) { res = {0, "kph"}; }
-    return res;
+    return m_maxSpd;
 }
 
 Train::Speed Train::currentSpeed() const
@@ -214,8 +222,12 @@ std::vector<Train::Car> Train::disassemble()
         auto& [type, car] = slot;
         if (car) {
             res.emplace_back(std::move(car));
+            ++m_missing[indexOf(type)];
+            ++m_missingTotal;
         }
     }
+    m_hasEngine = false;
+    m_maxSpd = Speed{0.0, "kph"};
     setState(State::not_assembled);
     return std::move(res);
 }
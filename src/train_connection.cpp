@@ -19,7 +19,11 @@ using TC = TrainConnection;
 TC::TrainConnection(std::string str)
 {
     auto iss = std::istringstream{str};
-    iss >> m_nbr >> m_origin >> m_destination >> m_departure >> m_arrival;
+    auto origin = std::string{};
+    auto destination = std::string{};
+    iss >> m_nbr >> origin >> destination >> m_departure >> m_arrival;
+    m_origin = internStation(origin);
+    m_destination = internStation(destination);
 
     double spd;
     iss >> spd;
@@ -36,12 +40,12 @@ int TC::trainNbr() const
     return m_nbr;
 }
 
-std::string TC::origin() const
+StationId TC::origin() const
 {
     return m_origin;
 }
 
-std::string TC::destination() const
+StationId TC::destination() const
 {
     return m_destination;
 }
@@ -7,10 +7,13 @@
 */
 
 #include "train_dispatcher.h"
-#include <algorithm>  // find_if
+#include "scope_trace.h"
+#include <algorithm>  // any_of, find_if, max, min, sort
 #include <cassert>
+#include <cmath>  // lround
 #include <iterator>  // begin, end
-#include <numeric>  // accumulate
+#include <limits>  // numeric_limits
+#include <memory>  // make_shared
 #include <stdexcept>  // out_of_range
 #include <string>
 #include <utility>  // move
@@ -28,13 +31,32 @@ using Duration = TrainDispatcher::Duration;
 TD::TrainDispatcher(std::vector<ConnObj> connections,
                     std::vector<StationObj> stns,
                     std::vector<PathObj> map)
-    : m_connections{std::move(connections)}
+    : TrainDispatcher{std::make_shared<const Network>(
+                              Network{std::move(connections), map, RouteTable{map}}),
+                      std::move(stns)}
+{
+}
+
+TD::TrainDispatcher(std::shared_ptr<const Network> network,
+                    std::vector<StationObj> stns)
+    : m_network{std::move(network)}
     , m_stations{std::move(stns)}
-    , m_map{std::move(map)}
 {
-    for (const auto& c: m_connections) {
+    PABO_TRACE_SCOPE("TrainDispatcher::TrainDispatcher");
+    m_trains.reserve(m_network->connections.size());
+    for (const auto& c: m_network->connections) {
         m_trains.emplace_back(c);
     }
+    m_tally = TrainTally{m_trains};
+    m_changes.assign(m_trains.size(), 0);
+
+    auto maxId = -1;
+    for (const auto& stn: m_stations) {
+        for (const auto car: stn.availableCars()) {
+            maxId = std::max(maxId, car->id());
+        }
+    }
+    m_carUsage.resize(static_cast<std::size_t>(maxId + 1));
 }
 
 
@@ -117,10 +139,8 @@ std::vector<int> TD::trainNumbers() const
 std::vector<int> TD::delayedTrainNumbers() const
 {
     auto res = std::vector<int>{};
-    for (const auto& train: m_trains) {
-        if (train.arrivalDelay() > Duration{0}) {
-            res.push_back(train.number());
-        }
+    for (const auto idx: m_tally.delayed()) {
+        res.push_back(m_trains[idx].number());
     }
     return res;
 }
@@ -128,10 +148,8 @@ std::vector<int> TD::delayedTrainNumbers() const
 std::vector<int> TD::nonDepartedTrainNumbers() const
 {
     auto res = std::vector<int>{};
-    for (const auto& train: m_trains) {
-        if (train.state() <= Train::State::ready) {
-            res.push_back(train.number());
-        }
+    for (const auto idx: m_tally.nonDeparted()) {
+        res.push_back(m_trains[idx].number());
     }
     return res;
 }
@@ -150,36 +168,32 @@ bool TD::trainIsAssembled(const int nbr) const
 
 bool TD::allTrainsFinished() const
 {
-    using std::begin;
-    using std::end;
-    return std::all_of(begin(m_trains), end(m_trains),
-                       [](const TrainObj& t) {
-                           return t.state() == Train::State::finished;
-                       });
+    return finishedTrainCount() == trainCount();
+}
+
+int TD::finishedTrainCount() const
+{
+    return trainCount(Train::State::finished);
+}
+
+int TD::trainCount() const
+{
+    return m_tally.trainCount();
+}
+
+int TD::trainCount(const Train::State s) const
+{
+    return m_tally.count(s);
 }
 
 TD::Duration TD::totalDepartureDelay() const
 {
-    using std::begin;
-    using std::end;
-    const auto delay = std::accumulate(begin(m_trains), end(m_trains), Duration{},
-                                       [this](Duration current, const TrainObj& t) {
-                                           auto delayToAdd = t.departureDelay();
-                                           return std::move(current) + std::move(delayToAdd);
-                                       });
-    return delay;
+    return m_tally.totalDepartureDelay();
 }
 
 TD::Duration TD::totalArrivalDelay() const
 {
-    using std::begin;
-    using std::end;
-    const auto delay = std::accumulate(begin(m_trains), end(m_trains), Duration{},
-                                       [this](Duration current, const TrainObj& t) {
-                                           auto delayToAdd = t.arrivalDelay();
-                                           return std::move(current) + std::move(delayToAdd);
-                                       });
-    return delay;
+    return m_tally.totalArrivalDelay();
 }
 
 Train::Speed TD::maxSpeed(const int nbr) const
@@ -191,13 +205,11 @@ Train::Speed TD::maxSpeed(const int nbr) const
 
 std::string TD::trainLocation(const Train& t) const
 {
-    if (t.state() < Train::State::running) {
-        return origin(t.number());
+    const auto station = stationOf(t);
+    if (station == noStation) {
+        return "In transit";
     }
-    if (t.state() > Train::State::running) {
-        return destination(t.number());
-    }
-    return "In transit";
+    return std::string{stationName(station)};
 }
 
 TrainView TD::viewTrainByVehicleId(const int id) const
@@ -224,13 +236,39 @@ TD::Distance TD::distance(int nbr) const
     return findDistance(nbr);
 }
 
-std::string TD::origin(int nbr) const
+Duration TD::minimumTravelTime() const
+{
+    auto res = Duration{std::numeric_limits<int>::max()};
+    for (const auto& conn: m_network->connections) {
+        const auto speed = conn.maxSpeed();
+        if (speed.value <= 0.0) { continue; }
+        res = std::min(res, profileOf(conn.trainNbr()).travelTime(speed));
+    }
+    return res;
+}
+
+bool TD::hasPath(const StationId from, const StationId to) const
+{
+    return m_network->routes.hasRoute(from, to);
+}
+
+TD::Distance TD::distance(const StationId from, const StationId to) const
+{
+    return findDistance(from, to);
+}
+
+Duration TD::travelTime(const StationId from, const StationId to, const Speed& speed) const
+{
+    return m_network->routes.profile(from, to).travelTime(speed);
+}
+
+StationId TD::origin(int nbr) const
 {
     const auto conn = findConnectionByNbr(nbr);
     return conn->origin();
 }
 
-std::string TD::destination(int nbr) const
+StationId TD::destination(int nbr) const
 {
     const auto conn = findConnectionByNbr(nbr);
     return conn->destination();
@@ -239,36 +277,87 @@ std::string TD::destination(int nbr) const
 //
 // Station queries
 //
+std::vector<StationId> TD::stationIds() const
+{
+    auto res = std::vector<StationId>{};
+    res.reserve(m_stations.size());
+    for (const auto& stn: m_stations) {
+        res.push_back(stn.id());
+    }
+    return res;
+}
+
 std::vector<std::string> TD::stationNames() const
 {
     auto res = std::vector<std::string>{};
     res.reserve(m_stations.size());
-    for (const auto stn: m_stations) {
+    for (const auto& stn: m_stations) {
         res.emplace_back(stn.name());
     }
     return res;
 }
 
-TD::StationView TD::viewStation(const std::string& name) const
+TD::StationView TD::viewStation(const StationId id) const
 {
-    const auto station = findStationByName(name);
-    if (station == m_stations.end()) {
-        throw std::out_of_range("Station does not exist: " + name);
-    }
-    return *station;
+    return *findStationById(id);
 }
 
-std::vector<const Train*> TD::trainsAtStation(const std::string& name)
+std::vector<const Train*> TD::trainsAtStation(const StationId id) const
 {
-    auto res = std::vector<const Train*>{};
-    for (const auto& train: m_trains) {
-        if (trainLocation(train) == name) {
-            res.push_back(&train);
+    // Only the trains that leave or reach the station can be at it.
+    const auto& timetable = m_network->timetable;
+    auto idx = std::vector<std::size_t>{};
+    for (const auto& e: timetable.departuresFrom(id)) {
+        if (m_trains[e.connection].state() < Train::State::running) {
+            idx.push_back(e.connection);
         }
     }
+    for (const auto& e: timetable.arrivalsAt(id)) {
+        if (m_trains[e.connection].state() > Train::State::running) {
+            idx.push_back(e.connection);
+        }
+    }
+    std::sort(idx.begin(), idx.end());
+
+    auto res = std::vector<const Train*>{};
+    res.reserve(idx.size());
+    for (const auto i: idx) {
+        res.push_back(&m_trains[i]);
+    }
     return res;
 }
 
+std::vector<TD::Departure> TD::departuresFrom(const StationId id) const
+{
+    auto res = std::vector<Departure>{};
+    const auto departures = m_network->timetable.departuresFrom(id);
+    res.reserve(departures.size());
+    for (const auto& [scheduled, idx]: departures) {
+        res.push_back({scheduled, &m_trains[idx]});
+    }
+    return res;
+}
+
+const Timetable& TD::timetable() const noexcept
+{
+    return m_network->timetable;
+}
+
+TrainView TD::viewTrain(const Timetable::Entry& entry) const
+{
+    return m_trains.at(entry.connection);
+}
+
+const TrainConnection& TD::viewConnection(const Timetable::Entry& entry) const
+{
+    return m_network->connections.at(entry.connection);
+}
+
+unsigned TD::changeCount(const Timetable::Entry& entry) const
+{
+    return m_changes.at(entry.connection);
+}
+
 //
 // Car queries
 //
@@ -288,6 +377,12 @@ auto TD::findCarById(const int id) const
     if (station != m_stations.end()) {
         return station->viewCar(id);
     }
+
+    const auto moved = std::find_if(begin(m_inTransit), end(m_inTransit),
+                                    [id](const CarInTransit& c) { return c.car->id() == id; });
+    if (moved != m_inTransit.end()) {
+        return CarView{moved->car.get()};
+    }
     const auto idStr = std::to_string(id);
     throw std::out_of_range("Can not find car with id: " + idStr);
 }
@@ -309,13 +404,27 @@ std::string TD::carLocation(const int id) const
 
     for (const auto& stn: m_stations) {
         if (stn.hasCar(id)) {
-            return stn.name();
+            return std::string{stn.name()};
+        }
+    }
+
+    for (const auto& [car, destination]: m_inTransit) {
+        if (car->id() == id) {
+            return "In transit to " + std::string{stationName(destination)};
         }
     }
 
     throw std::out_of_range("No vehicle exists with id: " + std::to_string(id));
 }
 
+int TD::carUsage(const int id) const
+{
+    if (id < 0 || static_cast<std::size_t>(id) >= m_carUsage.size()) {
+        return 0;
+    }
+    return m_carUsage[id];
+}
+
 std::vector<TD::CarView> TD::viewAllCars() const
 {
     auto res = std::vector<CarView>{};
@@ -324,16 +433,20 @@ std::vector<TD::CarView> TD::viewAllCars() const
 
     using std::begin;
     using std::end;
-    for (const auto train: m_trains) {
+    for (const auto& train: m_trains) {
         const auto cars = train.attachedCars();
         res.insert(end(res), begin(cars), end(cars));
     }
 
-    for (const auto stn: m_stations) {
+    for (const auto& stn: m_stations) {
         const auto cars = stn.availableCars();
         res.insert(end(res), begin(cars), end(cars));
     }
 
+    for (const auto& moved: m_inTransit) {
+        res.push_back(moved.car.get());
+    }
+
     return res;
 }
 
@@ -343,12 +456,27 @@ std::vector<TD::CarView> TD::viewAllCars() const
 
 void TD::tryAssembleTrain(const int nbr)
 {
+    static const auto lowestId = LowestIdPolicy{};
+    tryAssembleTrain(nbr, lowestId);
+}
+
+void TD::tryAssembleTrain(const int nbr, const AllocationPolicy& policy)
+{
+    PABO_TRACE_SCOPE("TrainDispatcher::tryAssembleTrain");
     auto conn = findConnectionByNbr(nbr);
-    auto station = findStationByName(conn->origin());
+    auto station = findStationById(conn->origin());
     auto train = findTrainByNbr(nbr);
-    for (const auto type: train->missingCarTypes()) {
-        if (station->hasCar(type)) {
-            auto car = station->getCar(type);
+    for (const auto type: vehicleTypes) {
+        for (auto n = train->missingCount(type); n > 0 && station->hasCar(type); --n) {
+            const auto choice = policy.choose({*train, type, *station, *this});
+            if (!choice) {
+                break;
+            }
+            auto car = station->getCar(choice->id());
+            const auto id = static_cast<std::size_t>(car->id());
+            if (id < m_carUsage.size()) {
+                ++m_carUsage[id];
+            }
             train->attachCar(std::move(car));
         }
     }
@@ -356,81 +484,291 @@ void TD::tryAssembleTrain(const int nbr)
 
 void TD::disassembleTrain(const int nbr)
 {
+    PABO_TRACE_SCOPE("TrainDispatcher::disassembleTrain");
     auto conn = findConnectionByNbr(nbr);
-    auto station = findStationByName(conn->destination());
+    auto station = findStationById(conn->destination());
     auto train = findTrainByNbr(nbr);
+    const auto before = TrainTally::Entry::of(*train);
     for (auto car: train->disassemble()) {
         station->addCar(std::move(car));
     }
+    trainChanged(train, before);
+}
+
+bool TD::waitForCars(const int nbr, const time::TimeOfDay nextAttempt)
+{
+    PABO_TRACE_SCOPE("TrainDispatcher::waitForCars");
+    auto conn = findConnectionByNbr(nbr);
+    auto station = findStationById(conn->origin());
+    const auto missing = findTrainByNbr(nbr)->missingCarTypes();
+    const auto available = std::any_of(missing.begin(), missing.end(),
+                                       [&station](Vehicle::Type type) {
+                                           return station->hasCar(type);
+                                       });
+    if (available) {
+        return false;
+    }
+    station->addWaiter({nbr, nextAttempt}, missing);
+    return true;
+}
+
+std::vector<Station::Waiter> TD::wakeWaitingTrains(
+        const StationId id,
+        const std::function<bool(const Station::Waiter&)>& accept)
+{
+    return findStationById(id)->wakeWaiters(accept);
+}
+
+std::vector<int> TD::sendCars(const StationId from, const StationId to,
+                              const Vehicle::Type type, const int count)
+{
+    auto station = findStationById(from);
+    auto res = std::vector<int>{};
+    for (auto n = count; n > 0 && station->hasCar(type); --n) {
+        auto car = station->getCar(type);
+        res.push_back(car->id());
+        m_inTransit.push_back({std::move(car), to});
+    }
+    return res;
+}
+
+void TD::receiveCars(const std::vector<int>& ids)
+{
+    PABO_TRACE_SCOPE("TrainDispatcher::receiveCars");
+    for (const auto id: ids) {
+        const auto moved = std::find_if(begin(m_inTransit), end(m_inTransit),
+                                        [id](const CarInTransit& c) { return c.car->id() == id; });
+        if (moved == m_inTransit.end()) {
+            throw std::out_of_range("No car in transit with id: " + std::to_string(id));
+        }
+        findStationById(moved->destination)->addCar(std::move(moved->car));
+        m_inTransit.erase(moved);
+    }
+}
+
+std::vector<Station::Waiter> TD::takeWaitingTrains()
+{
+    auto res = std::vector<Station::Waiter>{};
+    for (auto& station: m_stations) {
+        auto waiters = station.takeWaiters();
+        res.insert(end(res), begin(waiters), end(waiters));
+    }
+    return res;
 }
 
 void TD::setStateOfTrain(const int nbr, Train::State s)
 {
+    PABO_TRACE_SCOPE("TrainDispatcher::setStateOfTrain");
     const auto train = findTrainByNbr(nbr);
+    const auto before = TrainTally::Entry::of(*train);
     train->setState(s);
+    trainChanged(train, before);
 }
 
 void TD::delayDeparture(int nbr, time::TimeOfDay delay)
 {
+    PABO_TRACE_SCOPE("TrainDispatcher::delayDeparture");
     auto train = findTrainByNbr(nbr);
     assert(train != m_trains.end());
     train->delayDeparture(delay.inMinutes());
+    ++m_changes[indexOf(train)];
+}
+
+void TD::delayArrival(const int nbr, time::TimeOfDay delay)
+{
+    PABO_TRACE_SCOPE("TrainDispatcher::delayArrival");
+    auto train = findTrainByNbr(nbr);
+    assert(train != m_trains.end());
+    train->delayArrival(delay.rawTime());
+    ++m_changes[indexOf(train)];
 }
 
 void TD::setDepartureDelay(const int nbr)
 {
+    PABO_TRACE_SCOPE("TrainDispatcher::setDepartureDelay");
     auto train = findTrainByNbr(nbr);
     assert(train != m_trains.end());
     const auto delay = calculateDelayOfStaticTrain(*train);
+    const auto before = TrainTally::Entry::of(*train);
     train->setDepartureDelay(delay);
+    trainChanged(train, before);
 }
 
 void TD::setArrivalDelay(const int nbr)
 {
+    PABO_TRACE_SCOPE("TrainDispatcher::setArrivalDelay");
     auto train = findTrainByNbr(nbr);
     assert(train != m_trains.end());
     const auto delay = calculateDelayOfRunningTrain(*train);
+    const auto before = TrainTally::Entry::of(*train);
     train->setArrivalDelay(delay);
+    trainChanged(train, before);
 }
 
 void TD::setOptimalSpeedOfTrain(const int nbr)
 {
+    PABO_TRACE_SCOPE("TrainDispatcher::setOptimalSpeedOfTrain");
+    const auto train = findTrainByNbr(nbr);
+    train->setSpeed(optimalSpeed(*train));
+}
+
+//
+// Track occupancy
+//
+
+void TD::setTracksPerPath(const int tracks)
+{
+    m_occupancy.clear();
+    if (tracks > 0) {
+        m_occupancy.assign(m_network->map.size(), TrackOccupancy{tracks});
+    }
+}
+
+time::TimeOfDay TD::earliestFreeDeparture(const int nbr) const
+{
+    const auto train = findTrainByNbr(nbr);
+    if (m_occupancy.empty()) {
+        return train->departure();
+    }
+    // A later departure moves every block, so the search starts over
+    // whenever a block has to wait.
+    const auto blocks = blocksOf(nbr, optimalSpeed(*train));
+    auto start = train->departure().rawTime();
+    for (auto i = std::size_t{0}; i < blocks.size();) {
+        const auto& b = blocks[i];
+        const auto begin = start + b.begin;
+        const auto free = m_occupancy[b.path].earliestFree(begin, b.end - b.begin);
+        if (free > begin) {
+            start += free - begin;
+            i = 0;
+        }
+        else {
+            ++i;
+        }
+    }
+    return time::TimeOfDay{start};
+}
+
+void TD::reserveTracks(const int nbr)
+{
+    PABO_TRACE_SCOPE("TrainDispatcher::reserveTracks");
+    if (m_occupancy.empty()) {
+        return;
+    }
     const auto train = findTrainByNbr(nbr);
-    const auto dist = findDistance(nbr);
+    const auto start = train->departure().rawTime();
+    for (const auto& b: blocksOf(nbr, train->currentSpeed())) {
+        m_occupancy[b.path].reserve(start + b.begin, start + b.end, nbr);
+    }
+}
+
+std::vector<int> TD::trainsOnPath(const StationId a, const StationId b,
+                                  const time::TimeOfDay time) const
+{
+    const auto& map = m_network->map;
+    const auto match = Path{a, b};
+    const auto path = std::find_if(map.begin(), map.end(),
+                                   [&match](const PathObj& p) { return p == match; });
+    if (path == map.end()) {
+        throw std::out_of_range("No path between " + std::string{stationName(a)} +
+                                " and " + std::string{stationName(b)});
+    }
+    if (m_occupancy.empty()) {
+        return {};
+    }
+    return m_occupancy[static_cast<std::size_t>(path - map.begin())].trainsAt(time.rawTime());
+}
+
+//
+// Calculations
+//
+
+TD::Speed TD::optimalSpeed(const Train& t) const
+{
+    const auto nbr = t.number();
+    const auto& profile = profileOf(nbr);
     const auto maxSpd = maxSpeed(nbr);
 
-    const auto minTravelTime = calcTravelTime(dist, maxSpd);
+    const auto minTravelTime = profile.travelTime(maxSpd);
 
     const auto schedArrival = scheduledTimeOfArrival(nbr);
-    const auto departure = train->departure();
+    const auto departure = t.departure();
 
     const auto optimalTravelTime = (departure > schedArrival)
                                            ? time::TimeOfDay{0}
                                            : schedArrival - departure;
 
     if (minTravelTime >= optimalTravelTime) {
-        train->setSpeed(maxSpd);
-        return;
+        return maxSpd;
     }
-    const auto optimalSpeed = calcSpeed(dist, optimalTravelTime);
-    train->setSpeed(optimalSpeed);
+    return profile.speedFor(optimalTravelTime);
 }
 
-//
-// Calculations
-//
-
 time::TimeOfDay TD::calculateDelayOfStaticTrain(const Train& t) const
 {
     const auto nbr = t.number();
     return t.departure() - scheduledTimeOfDeparture(nbr);
 }
 
+//
+// Platforms
+//
+
+bool TD::takePlatform(const int nbr, const StationId id, const time::TimeOfDay time)
+{
+    PABO_TRACE_SCOPE("TrainDispatcher::takePlatform");
+    return findStationById(id)->takePlatform(time, nbr);
+}
+
+std::optional<PlatformOccupancy::Waiter> TD::leavePlatform(
+        const StationId id, const time::TimeOfDay time,
+        const std::function<bool(const PlatformOccupancy::Waiter&)>& accept)
+{
+    PABO_TRACE_SCOPE("TrainDispatcher::leavePlatform");
+    return findStationById(id)->leavePlatform(time, accept);
+}
+
+std::vector<PlatformOccupancy::Waiter> TD::takePlatformWaiters()
+{
+    auto res = std::vector<PlatformOccupancy::Waiter>{};
+    for (auto& station: m_stations) {
+        auto waiters = station.takePlatformWaiters();
+        res.insert(end(res), begin(waiters), end(waiters));
+    }
+    return res;
+}
+
+Train TD::saveTrainState(const int nbr) const
+{
+    return *findTrainByNbr(nbr);
+}
+
+void TD::restoreTrainState(Train saved)
+{
+    PABO_TRACE_SCOPE("TrainDispatcher::restoreTrainState");
+    auto train = findTrainByNbr(saved.number());
+    const auto before = TrainTally::Entry::of(*train);
+    *train = std::move(saved);
+    trainChanged(train, before);
+}
+
+Station TD::saveStationState(const StationId id) const
+{
+    return *findStationById(id);
+}
+
+void TD::restoreStationState(Station saved)
+{
+    PABO_TRACE_SCOPE("TrainDispatcher::restoreStationState");
+    auto station = findStationById(saved.id());
+    *station = std::move(saved);
+}
+
 time::TimeOfDay TD::calculateDelayOfRunningTrain(const Train& t) const
 {
     const auto nbr = t.number();
-    const auto travelTime = calcTravelTime(distance(nbr), t.currentSpeed());
-    const auto actualArrival = t.departure() + travelTime;
+    const auto travelTime = profileOf(nbr).travelTime(t.currentSpeed());
+    const auto actualArrival = t.departure() + travelTime + t.arrivalWait();
     return actualArrival - scheduledTimeOfArrival(nbr);
 }
 
@@ -467,77 +805,113 @@ auto TD::findTrainByNbr(const int nbr) -> std::vector<TrainObj>::iterator
     return train;
 }
 
+std::size_t TD::indexOf(const std::vector<TrainObj>::const_iterator train) const
+{
+    using std::begin;
+    return static_cast<std::size_t>(train - begin(m_trains));
+}
+
 auto TD::findConnectionByNbr(int nbr) const -> std::vector<ConnObj>::const_iterator
 {
     using std::begin;
     using std::end;
-    const auto conn = std::find_if(begin(m_connections), end(m_connections),
+    const auto& connections = m_network->connections;
+    const auto conn = std::find_if(begin(connections), end(connections),
                                    [nbr](const ConnObj& c) {
                                        return c.trainNbr() == nbr;
                                    });
-    if (conn == m_connections.end()) {
+    if (conn == connections.end()) {
         throw std::out_of_range("Connection does not exist: " + std::to_string(nbr));
     }
     return conn;
 }
 
-auto TD::findConnectionByNbr(int nbr) -> std::vector<ConnObj>::iterator
+const SpeedProfile& TD::profileOf(const int nbr) const
 {
     using std::begin;
-    using std::end;
-    const auto conn = std::find_if(begin(m_connections), end(m_connections),
-                                   [nbr](const ConnObj& c) {
-                                       return c.trainNbr() == nbr;
-                                   });
-    if (conn == m_connections.end()) {
-        throw std::out_of_range("Connection does not exist: " + std::to_string(nbr));
+    const auto conn = findConnectionByNbr(nbr);
+    return m_network->profiles[static_cast<std::size_t>(conn - begin(m_network->connections))];
+}
+
+std::vector<TD::Block> TD::blocksOf(const int nbr, const Speed& speed) const
+{
+    const auto conn = findConnectionByNbr(nbr);
+    const auto legs = m_network->routes.legs(conn->origin(), conn->destination());
+    // The last block ends at the arrival, whatever the rounding of the
+    // ones before it.
+    const auto arrival = profileOf(nbr).travelTime(speed).rawTime();
+    auto res = std::vector<Block>{};
+    res.reserve(legs.size());
+    auto hours = 0.0;
+    for (auto i = std::size_t{0}; i < legs.size(); ++i) {
+        const auto& leg = legs[i];
+        const auto begin = std::min(static_cast<int>(std::lround(hours * 60.0)), arrival);
+        hours += leg.distance / std::min(speed.value, leg.speedLimit);
+        const auto end = (i + 1 == legs.size())
+                                 ? arrival
+                                 : std::min(static_cast<int>(std::lround(hours * 60.0)), arrival);
+        // Even a train that passes within a minute takes the track.
+        res.push_back({leg.path, begin, std::max(end, begin + 1)});
     }
-    return conn;
+    return res;
 }
 
-auto TD::findStationByName(const std::string& name) -> std::vector<StationObj>::iterator
+auto TD::findStationById(const StationId id) -> std::vector<StationObj>::iterator
 {
     using std::begin;
     using std::end;
     const auto station = std::find_if(begin(m_stations), end(m_stations),
-                                      [&name](const StationObj& s) {
-                                          return s.name() == name;
+                                      [id](const StationObj& s) {
+                                          return s.id() == id;
                                       });
     if (station == m_stations.end()) {
-        throw std::out_of_range("Station does not exist: " + name);
+        throw std::out_of_range("Station does not exist: " + std::string{stationName(id)});
     }
     return station;
 }
 
-auto TD::findStationByName(const std::string& name) const -> std::vector<StationObj>::const_iterator
+auto TD::findStationById(const StationId id) const -> std::vector<StationObj>::const_iterator
 {
     using std::begin;
     using std::end;
     const auto station = std::find_if(begin(m_stations), end(m_stations),
-                                      [&name](const StationObj& s) {
-                                          return s.name() == name;
+                                      [id](const StationObj& s) {
+                                          return s.id() == id;
                                       });
     if (station == m_stations.end()) {
-        throw std::out_of_range("Station does not exist: " + name);
+        throw std::out_of_range("Station does not exist: " + std::string{stationName(id)});
     }
     return station;
 }
 
+void TD::trainChanged(const std::vector<TrainObj>::const_iterator train,
+                      const TrainTally::Entry& before)
+{
+    const auto idx = indexOf(train);
+    m_tally.update(idx, before, TrainTally::Entry::of(*train));
+    ++m_changes[idx];
+}
+
+StationId TD::stationOf(const Train& t) const
+{
+    if (t.state() < Train::State::running) {
+        return origin(t.number());
+    }
+    if (t.state() > Train::State::running) {
+        return destination(t.number());
+    }
+    return noStation;
+}
+
 TD::Distance TD::findDistance(int nbr) const
 {
     const auto& conn = findConnectionByNbr(nbr);
     return findDistance(conn->origin(), conn->destination());
 }
 
-Capacity<double> TD::findDistance(std::string station1,
-                                  std::string station2) const
+Capacity<double> TD::findDistance(const StationId station1, const StationId station2) const
 {
-    using std::begin;
-    using std::end;
-    const auto match = Path{std::move(station1), std::move(station2)};
-    auto path = std::find_if(begin(m_map), end(m_map),
-                             [&match](const PathObj& p) { return p == match; });
-    return path->distance();
+    return m_network->routes.distance(station1, station2);
 }
 
 //
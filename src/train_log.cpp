@@ -1,8 +1,9 @@
 #include "train_log.h"
-#include <iterator>  // begin, end
+#include <iterator>  // begin, end, back_inserter
+#include "scope_trace.h"
 #include "train_dispatcher.h"
 #include <cassert>
-#include <algorithm>  // sort
+#include <algorithm>  // upper_bound, merge, partition_point
 #include <utility>  // move
 #include "time_point.h"
 
@@ -11,20 +12,94 @@ namespace pabo::train {
 using time::TimeOfDay;
 using TrainView = TrainDispatcher::TrainView;
 
+bool recordOrder(const TrainRecord& lhs, const TrainRecord& rhs)
+{
+    if (lhs.time != rhs.time) {
+        return lhs.time < rhs.time;
+    }
+    return lhs.train.number < rhs.train.number;
+}
+
+TrainSummary::TrainSummary(const Train& t, const TrainDispatcher& disp)
+    : number{t.number()}
+    , state{t.state()}
+    , origin{disp.origin(number)}
+    , destination{disp.destination(number)}
+    , scheduledDeparture{disp.scheduledTimeOfDeparture(number)}
+    , estimatedDeparture{t.departure()}
+    , scheduledArrival{disp.scheduledTimeOfArrival(number)}
+    , estimatedArrival{disp.estimatedTimeOfArrival(t)}
+    , departureDelay{disp.departureDelay(t)}
+    , arrivalDelay{disp.arrivalDelay(t)}
+    , speed{t.currentSpeed()}
+{
+}
+
 void TrainLog::log(TrainRecord tr)
 {
-    m_history.emplace_back(std::move(tr));
-    sort();
+    PABO_TRACE_SCOPE("TrainLog::log");
+    for (const auto& sink: m_sinks) {
+        sink(tr);
+    }
+    // Records almost always arrive in order, so this is an append.
+    using std::begin;
+    using std::end;
+    const auto pos = std::upper_bound(begin(m_history), end(m_history),
+                                      tr, recordOrder);
+    m_history.insert(pos, std::move(tr));
+    trim();
+}
+
+void TrainLog::addSink(Sink sink)
+{
+    m_sinks.emplace_back(std::move(sink));
 }
 
-void TrainLog::sort()
+void TrainLog::clearSinks()
+{
+    m_sinks.clear();
+}
+
+void TrainLog::setWindow(std::size_t records)
+{
+    m_window = records;
+    trim();
+}
+
+void TrainLog::trim()
+{
+    if (m_window == 0) { return; }
+    while (m_history.size() > m_window) {
+        m_history.pop_front();
+    }
+}
+
+void TrainLog::merge(TrainLog other)
 {
     using std::begin;
     using std::end;
-    std::sort(begin(m_history), end(m_history),
-              [](const TrainRecord& lhs, const TrainRecord& rhs) {
-                  return lhs.time < rhs.time;
-              });
+    for (const auto& sink: m_sinks) {
+        for (const auto& tr: other.m_history) {
+            sink(tr);
+        }
+    }
+    // Logs are usually merged in order, so this is an append.
+    if (m_history.empty() || other.m_history.empty() ||
+        !recordOrder(other.m_history.front(), m_history.back())) {
+        m_history.insert(end(m_history),
+                         std::make_move_iterator(begin(other.m_history)),
+                         std::make_move_iterator(end(other.m_history)));
+        trim();
+        return;
+    }
+    auto res = std::deque<TrainRecord>{};
+    std::merge(std::make_move_iterator(begin(m_history)),
+               std::make_move_iterator(end(m_history)),
+               std::make_move_iterator(begin(other.m_history)),
+               std::make_move_iterator(end(other.m_history)),
+               std::back_inserter(res), recordOrder);
+    m_history = std::move(res);
+    trim();
 }
 
 std::vector<TrainRecord> TrainLog::view(time::TimeOfDay from, time::TimeOfDay to)
@@ -48,6 +123,22 @@ std::vector<TrainRecord> TrainLog::view(time::TimeOfDay from, time::TimeOfDay to
     return res;
 }
 
+auto TrainLog::range(time::TimeOfDay from, time::TimeOfDay to) const
+        -> std::pair<ConstIterator, ConstIterator>
+{
+    using std::begin;
+    using std::end;
+    const auto first = std::partition_point(begin(m_history), end(m_history),
+                                            [&from](const TrainRecord& tr) {
+                                                return tr.time < from;
+                                            });
+    const auto last = std::partition_point(first, end(m_history),
+                                           [&to](const TrainRecord& tr) {
+                                               return tr.time <= to;
+                                           });
+    return {first, last};
+}
+
 TrainRecord TrainLog::viewLast()
 {
     assert(!m_history.empty());
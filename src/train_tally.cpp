@@ -0,0 +1,151 @@
+/**
+    @file src/train_tally.cpp
+    @author Patrik Bogren (pabo1800)
+    @date June 2019
+    @version: 0.1
+    @brief The implementation of the TrainTally class.
+*/
+
+#include "train_tally.h"
+#include <iterator>  // begin, end
+
+namespace pabo::train {
+
+namespace {
+
+constexpr auto relaxed = std::memory_order_relaxed;
+
+}  // namespace
+
+TrainTally::Entry TrainTally::Entry::of(const Train& t)
+{
+    return {t.state(), t.departureDelay().rawTime(), t.arrivalDelay().rawTime()};
+}
+
+TrainTally::TrainTally(const std::vector<Train>& trains)
+{
+    for (auto idx = std::size_t{0}; idx < trains.size(); ++idx) {
+        add(idx, Entry::of(trains[idx]));
+    }
+}
+
+TrainTally::TrainTally(const TrainTally& other)
+{
+    *this = other;
+}
+
+TrainTally& TrainTally::operator=(const TrainTally& other)
+{
+    if (this == &other) {
+        return *this;
+    }
+    const auto lock = std::scoped_lock{m_mutex, other.m_mutex};
+    m_trainCount = other.m_trainCount;
+    for (auto s = std::size_t{0}; s < stateCount; ++s) {
+        m_stateCounts[s].store(other.m_stateCounts[s].load(relaxed), relaxed);
+    }
+    m_departureDelay.store(other.m_departureDelay.load(relaxed), relaxed);
+    m_arrivalDelay.store(other.m_arrivalDelay.load(relaxed), relaxed);
+    m_delayed = other.m_delayed;
+    m_nonDeparted = other.m_nonDeparted;
+    return *this;
+}
+
+void TrainTally::add(const std::size_t idx, const Entry& e)
+{
+    ++m_trainCount;
+    m_stateCounts[static_cast<std::size_t>(e.state)].fetch_add(1, relaxed);
+    m_departureDelay.fetch_add(e.departureDelay, relaxed);
+    m_arrivalDelay.fetch_add(e.arrivalDelay, relaxed);
+    if (isDelayed(e)) {
+        m_delayed.insert(idx);
+    }
+    if (!hasDeparted(e)) {
+        m_nonDeparted.insert(idx);
+    }
+}
+
+void TrainTally::update(const std::size_t idx, const Entry& before, const Entry& after)
+{
+    if (before.state != after.state) {
+        m_stateCounts[static_cast<std::size_t>(before.state)].fetch_sub(1, relaxed);
+        m_stateCounts[static_cast<std::size_t>(after.state)].fetch_add(1, relaxed);
+    }
+    if (before.departureDelay != after.departureDelay) {
+        m_departureDelay.fetch_add(after.departureDelay - before.departureDelay, relaxed);
+    }
+    if (before.arrivalDelay != after.arrivalDelay) {
+        m_arrivalDelay.fetch_add(after.arrivalDelay - before.arrivalDelay, relaxed);
+    }
+
+    const auto delayChanged = isDelayed(before) != isDelayed(after);
+    const auto departureChanged = hasDeparted(before) != hasDeparted(after);
+    if (!delayChanged && !departureChanged) {
+        return;
+    }
+    const auto lock = std::scoped_lock{m_mutex};
+    if (delayChanged) {
+        if (isDelayed(after)) {
+            m_delayed.insert(idx);
+        }
+        else {
+            m_delayed.erase(idx);
+        }
+    }
+    if (departureChanged) {
+        if (hasDeparted(after)) {
+            m_nonDeparted.erase(idx);
+        }
+        else {
+            m_nonDeparted.insert(idx);
+        }
+    }
+}
+
+int TrainTally::trainCount() const noexcept
+{
+    return m_trainCount;
+}
+
+int TrainTally::count(const Train::State s) const noexcept
+{
+    return m_stateCounts[static_cast<std::size_t>(s)].load(relaxed);
+}
+
+TrainTally::Duration TrainTally::totalDepartureDelay() const noexcept
+{
+    return Duration{m_departureDelay.load(relaxed)};
+}
+
+TrainTally::Duration TrainTally::totalArrivalDelay() const noexcept
+{
+    return Duration{m_arrivalDelay.load(relaxed)};
+}
+
+std::vector<std::size_t> TrainTally::delayed() const
+{
+    using std::begin;
+    using std::end;
+    const auto lock = std::scoped_lock{m_mutex};
+    return {begin(m_delayed), end(m_delayed)};
+}
+
+std::vector<std::size_t> TrainTally::nonDeparted() const
+{
+    using std::begin;
+    using std::end;
+    const auto lock = std::scoped_lock{m_mutex};
+    return {begin(m_nonDeparted), end(m_nonDeparted)};
+}
+
+bool TrainTally::isDelayed(const Entry& e) noexcept
+{
+    return e.arrivalDelay > 0;
+}
+
+bool TrainTally::hasDeparted(const Entry& e) noexcept
+{
+    return e.state > Train::State::ready;
+}
+
+}  // namespace pabo::train
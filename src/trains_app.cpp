@@ -1,5 +1,10 @@
+#include "allocation_policy.h"
 #include "console_IO.h"
+#include "departure_board.h"
+#include "parameter_sweep.h"
 #include "path.h"
+#include "scenario.h"
+#include "scope_trace.h"
 #include "simulator.h"
 #include "station.h"
 #include "time_point.h"
@@ -7,10 +12,13 @@
 #include "train_dispatcher.h"
 #include "start_event.h"
 #include "trains_app.h"
+#include <algorithm>  // find_if, max_element
 #include <cassert>
 #include <fstream>
+#include <iomanip>  // setprecision
 #include <iterator>  // begin, end
 #include <memory>  // make_unique
+#include <sstream>  // istringstream, ostringstream
 #include <stdexcept>
 #include <string>
 #include <utility>
@@ -29,11 +37,15 @@ using train::Event;
 
 std::vector<TrainConnection> readConnectionsFromFile(const std::string&);
 std::vector<Station> readStationsFromFile(const std::string&);
+std::vector<Station> readFleetFromFile(const std::string&);
 std::vector<Path> readMapFromFile(const std::string&);
+SweepGrid readSweepGridFromFile(const std::string&);
+std::vector<Scenario> readScenariosFromFile(const std::string&);
 
 
 void App::initialize()
 {
+    PABO_TRACE_SCOPE("TrainsApp::initialize");
     clearScreen();
     print("Reading Trains.txt...");
     auto connections = readConnectionsFromFile("Trains.txt");
@@ -48,13 +60,15 @@ void App::initialize()
     auto map = readMapFromFile("TrainMap.txt");
     println("Ok!");
 
-    m_dispatch = TrainDispatcher(std::move(connections),
-                                 std::move(stations),
-                                 std::move(map));
+    auto routes = RouteTable{map, m_pool};
+    m_network = std::make_shared<const Network>(
+            Network{std::move(connections), std::move(map), std::move(routes)});
+    m_dispatch = TrainDispatcher(m_network, std::move(stations));
 }
 
 std::vector<TrainConnection> readConnectionsFromFile(const std::string& fname)
 {
+    PABO_TRACE_SCOPE("readConnectionsFromFile");
     auto file = std::ifstream{fname};
     if (!file) { throw std::runtime_error("Could not read " + fname + '.'); }
 
@@ -69,23 +83,34 @@ std::vector<TrainConnection> readConnectionsFromFile(const std::string& fname)
 
 std::vector<Station> readStationsFromFile(const std::string& fname)
 {
+    auto stations = readFleetFromFile(fname);
+    auto carCount = 0;
+    for (const auto& station: stations) {
+        carCount += station.carCount();
+    }
+    assert(stations.size() == 8);
+    assert(carCount == 741);
+
+    return stations;
+}
+
+// Reads stations without checking them against the project data.
+std::vector<Station> readFleetFromFile(const std::string& fname)
+{
+    PABO_TRACE_SCOPE("readFleetFromFile");
     auto file = std::ifstream{fname};
     if (!file) { throw std::runtime_error("Could not read " + fname + '.'); }
 
     std::vector<Station> stations{};
-    auto carCount = 0;
     for (Station station; file >> station;) {
-        carCount += station.carCount();
         stations.emplace_back(std::move(station));
     }
-    assert(stations.size() == 8);
-    assert(carCount == 741);
-
     return stations;
 }
 
 std::vector<Path> readMapFromFile(const std::string& fname)
 {
+    PABO_TRACE_SCOPE("readMapFromFile");
     auto file = std::ifstream{fname};
     if (!file) { throw std::runtime_error("Could not read " + fname + '.'); }
 
@@ -97,8 +122,102 @@ std::vector<Path> readMapFromFile(const std::string& fname)
     return map;
 }
 
+SweepGrid readSweepGridFromFile(const std::string& fname)
+{
+    PABO_TRACE_SCOPE("readSweepGridFromFile");
+    auto file = std::ifstream{fname};
+    if (!file) { throw std::runtime_error("Could not read " + fname + '.'); }
+
+    // Each line holds the name of a parameter followed by the
+    // minutes to try. Lines starting with # are comments.
+    auto grid = SweepGrid{};
+    for (std::string line; std::getline(file, line);) {
+        if (line.empty() || line.front() == '#') { continue; }
+        auto iss = std::istringstream{line};
+        auto name = std::string{};
+        iss >> name;
+        auto minutes = std::vector<int>{};
+        for (int value; iss >> value;) {
+            minutes.push_back(value);
+        }
+        grid.setValues(name, std::move(minutes));
+    }
+    return grid;
+}
+
+std::vector<Scenario> readScenariosFromFile(const std::string& fname)
+{
+    PABO_TRACE_SCOPE("readScenariosFromFile");
+    auto file = std::ifstream{fname};
+    if (!file) { throw std::runtime_error("Could not read " + fname + '.'); }
+
+    // Each line holds a name, a start and an end time followed by
+    // the options "remove <ids...>", "stations <file>",
+    // "allocation <policy>", "repositioning", "tracks <count>" and
+    // "platforms <count>".
+    auto scenarios = std::vector<Scenario>{};
+    for (std::string line; std::getline(file, line);) {
+        if (line.empty() || line.front() == '#') { continue; }
+        auto iss = std::istringstream{line};
+        auto scenario = Scenario{};
+        if (!(iss >> scenario.name >> scenario.start >> scenario.end)) {
+            throw std::runtime_error("Bad scenario in " + fname + ": " + line);
+        }
+        for (std::string option; iss >> option;) {
+            if (option == "remove") {
+                for (int id; iss >> id;) {
+                    scenario.removedVehicles.push_back(id);
+                }
+                iss.clear();
+            }
+            else if (option == "stations") {
+                auto stationFile = std::string{};
+                iss >> stationFile;
+                scenario.fleet = readFleetFromFile(stationFile);
+            }
+            else if (option == "allocation") {
+                auto policy = std::string{};
+                iss >> policy;
+                scenario.config.allocation = makeAllocationPolicy(policy);
+            }
+            else if (option == "repositioning") {
+                scenario.config.repositioning = true;
+            }
+            else if (option == "tracks") {
+                if (!(iss >> scenario.config.tracksPerPath)) {
+                    throw std::runtime_error("Bad track count in " + fname + ": " + line);
+                }
+            }
+            else if (option == "platforms") {
+                if (!(iss >> scenario.platforms) || scenario.platforms < 0) {
+                    throw std::runtime_error("Bad platform count in " + fname + ": " + line);
+                }
+            }
+            else {
+                throw std::runtime_error("Unknown scenario option: " + option);
+            }
+        }
+        scenarios.emplace_back(std::move(scenario));
+    }
+    return scenarios;
+}
+
 void App::start()
 {
+    if (m_streamWindow > 0) {
+        startLogStream();
+    }
+    if (m_traceEnabled) {
+        startEventTrace();
+    }
+    if (m_metricsEnabled) {
+        const auto numbers = m_dispatch.trainNumbers();
+        const auto highest = numbers.empty()
+                ? 0
+                : *std::max_element(numbers.begin(), numbers.end());
+        m_metrics = std::make_unique<EventMetrics>(highest);
+        m_sim.addObserver(*m_metrics);
+    }
     auto e = std::make_unique<StartEvent>(m_sim, m_dispatch);
     m_sim.scheduleEvent(std::move(e));
     m_sim.runNextEvent();
@@ -106,10 +225,76 @@ void App::start()
 
 void App::reset()
 {
+    PABO_TRACE_SCOPE("TrainsApp::reset");
+#ifdef PABO_TRACING
+    // A trace covers one run, from the reset on.
+    clearScopeTraces();
+#endif
     m_sim.reset();
+    m_logStream.reset();
+    m_trace.reset();
+    if (m_metrics) {
+        m_sim.removeObserver(*m_metrics);
+        m_metrics.reset();
+    }
     m_log = TrainLog{};
     m_carLog = CarLog{};
     initialize();
+    for (auto& b: m_boards) {
+        b.reset();
+    }
+}
+
+void App::runParameterSweep()
+{
+    clearScreen();
+    print("Reading SweepGrid.txt...");
+    const auto configs = readSweepGridFromFile("SweepGrid.txt").configurations();
+    println("Ok!");
+
+    auto sweep = ParameterSweep{m_network, m_initialStationStates};
+    sweep.setTimeSpan(m_sim.startTime(), m_sim.endTime());
+
+    const auto runs = std::to_string(configs.size());
+    const auto threads = std::to_string(m_pool.size());
+    print("Running " + runs + " simulations on " + threads + " threads...");
+    const auto results = sweep.run(configs, m_pool);
+    println("Ok!");
+
+    using namespace std::string_literals;
+    const auto filename = "Sweep.csv"s;
+    auto file = std::ofstream(filename);
+    if (!file) {
+        throw std::runtime_error("Could not write to " + filename);
+    }
+    writeCsv(file, results);
+    println("Wrote results to "s + filename);
+    waitForEnter();
+}
+
+void App::runScenarioBatch()
+{
+    clearScreen();
+    print("Reading Scenarios.txt...");
+    const auto scenarios = readScenariosFromFile("Scenarios.txt");
+    println("Ok!");
+
+    const auto runner = ScenarioRunner{m_network, m_initialStationStates};
+    const auto runs = std::to_string(scenarios.size());
+    const auto threads = std::to_string(m_pool.size());
+    print("Running " + runs + " scenarios on " + threads + " threads...");
+    const auto results = runner.run(scenarios, m_pool);
+    println("Ok!");
+
+    using namespace std::string_literals;
+    const auto filename = "Scenarios.csv"s;
+    auto file = std::ofstream(filename);
+    if (!file) {
+        throw std::runtime_error("Could not write to " + filename);
+    }
+    writeCsv(file, results);
+    println("Wrote results to "s + filename);
+    waitForEnter();
 }
 
 void App::setStartTime()
@@ -124,6 +309,31 @@ void App::setEndTime()
     m_sim.setEndTime(time);
 }
 
+void App::setExecutionMode()
+{
+    println("1. sequential\n2. batched parallel\n"
+            "3. conservative parallel\n4. optimistic parallel");
+    const auto choice = get<int>("> ");
+    switch (choice) {
+    case 1:
+        m_sim.setExecution(Simulator::Execution::sequential);
+        break;
+    case 2:
+        m_sim.setExecution(Simulator::Execution::batched);
+        break;
+    case 3:
+        m_sim.setExecution(Simulator::Execution::conservative);
+        break;
+    case 4:
+        m_sim.setOptimisticWindow(
+                time::TimeOfDay{get<int>("Enter optimistic window in minutes: ")});
+        m_sim.setExecution(Simulator::Execution::optimistic);
+        break;
+    default:
+        throw std::out_of_range("Not a valid execution mode!");
+    }
+}
+
 void App::printStartAndEndTimes()
 {
     print("Current start time: ");
@@ -132,6 +342,12 @@ void App::printStartAndEndTimes()
     println(m_sim.endTime());
 }
 
+void App::printExecutionMode()
+{
+    print("Execution mode: ");
+    println(m_sim.execution());
+}
+
 void App::printInterval()
 {
     print("Current interval: ");
@@ -149,6 +365,21 @@ void App::printCurrentTime()
     println(m_sim.currentTime());
 }
 
+void App::printProgress()
+{
+    using namespace std::string_literals;
+    auto line = "Trains ("s + std::to_string(m_dispatch.trainCount()) + "):";
+    auto separator = " ";
+    for (const auto state: trainStates) {
+        const auto count = m_dispatch.trainCount(state);
+        if (count > 0) {
+            line += separator + toString(state) + " " + std::to_string(count);
+            separator = ", ";
+        }
+    }
+    println(line);
+}
+
 void App::printNewTime()
 {
     print("\nTime is now ");
@@ -166,10 +397,12 @@ void App::changeInterval()
 
 void App::runNextInterval()
 {
+    PABO_TRACE_SCOPE("TrainsApp::runNextInterval");
     const auto start = m_sim.currentTime();
     const auto stop = m_sim.nextStopTime();
     m_sim.runNextInterval();
     printHistory(start, stop);
+    printDepartureBoards();
     printNewTime();
     logIfFinished();
     waitForEnter();
@@ -179,19 +412,24 @@ void App::logIfFinished()
 {
     if (simulationIsFinished()) {
         writeLogToFile();
+#ifdef PABO_TRACING
+        writeScopeTrace();
+#endif
     }
 }
 
 void App::printHistory(time::TimeOfDay start, time::TimeOfDay end)
 {
-    auto records = m_log.view(start, end);
-    m_printer.print(std::begin(records), std::end(records));
+    const auto [first, last] = m_log.range(start, end);
+    m_printer.print(first, last);
 }
 
 void App::runNextEvent()
 {
+    PABO_TRACE_SCOPE("TrainsApp::runNextEvent");
     m_sim.runNextEvent();
     printLast();
+    printDepartureBoards();
     printNewTime();
     logIfFinished();
     waitForEnter();
@@ -200,11 +438,17 @@ void App::runNextEvent()
 void App::runUntilComplete()
 {
     const auto start = m_sim.currentTime();
-    m_sim.runToCompletion();
+    m_sim.runToCompletion(m_pool);
     const auto stop = m_sim.currentTime();
     printHistory(start, stop);
     printNewTime();
     writeLogToFile();
+    if (m_metrics) {
+        writeEventMetrics();
+    }
+#ifdef PABO_TRACING
+    writeScopeTrace();
+#endif
     waitForEnter();
 }
 
@@ -304,8 +548,8 @@ void App::showAllStations()
 {
     m_printer.println("All stations: ");
     m_printer.println("---");
-    for (const auto name: m_dispatch.stationNames()) {
-        const auto station = m_dispatch.viewStation(name);
+    for (const auto id: m_dispatch.stationIds()) {
+        const auto station = m_dispatch.viewStation(id);
         m_printer.print(station);
     }
     waitForEnter();
@@ -319,8 +563,8 @@ void App::showStationByName()
     showAllStationNames();
     const auto choice = get<int>("Enter nbr: ");
     try {
-        const auto name = m_dispatch.stationNames().at(choice - 1);
-        const auto station = m_dispatch.viewStation(name);
+        const auto id = m_dispatch.stationIds().at(choice - 1);
+        const auto station = m_dispatch.viewStation(id);
         clearScreen();
         m_printer.print(station);
         waitForEnter();
@@ -330,6 +574,77 @@ void App::showStationByName()
     }
 }
 
+void App::showStationTimetable()
+{
+    clearScreen();
+    m_printer.println("Show station timetable");
+    m_printer.println("---");
+    showAllStationNames();
+    const auto choice = get<int>("Enter nbr: ");
+    auto id = noStation;
+    try {
+        id = m_dispatch.stationIds().at(choice - 1);
+    }
+    catch (const std::out_of_range&) {
+        throw std::out_of_range("No such option!");
+    }
+    const auto from = time::TimeOfDay{get<std::string>("Enter first time (hh:mm): ")};
+    const auto to = time::TimeOfDay{get<std::string>("Enter last time (hh:mm): ")};
+
+    // The last time is included.
+    const auto& timetable = m_dispatch.timetable();
+    const auto end = to + time::TimeOfDay{1};
+    clearScreen();
+    m_printer.println(std::string{stationName(id)} + " " + from.asString() + " - " + to.asString());
+    m_printer.println("Departures");
+    m_printer.println("----------");
+    m_printer.printDepartures(timetable.departuresFrom(id, from, end));
+    m_printer.println();
+    m_printer.println("Arrivals");
+    m_printer.println("--------");
+    m_printer.printArrivals(timetable.arrivalsAt(id, from, end));
+    waitForEnter();
+}
+
+void App::toggleDepartureBoard()
+{
+    clearScreen();
+    m_printer.println("Toggle departure board");
+    m_printer.println("---");
+    showAllStationNames();
+    const auto choice = get<int>("Enter nbr: ");
+    auto id = noStation;
+    try {
+        id = m_dispatch.stationIds().at(choice - 1);
+    }
+    catch (const std::out_of_range&) {
+        throw std::out_of_range("No such option!");
+    }
+
+    const auto shown = std::find_if(m_boards.begin(), m_boards.end(),
+                                    [id](const auto& b) { return b.station() == id; });
+    if (shown != m_boards.end()) {
+        m_boards.erase(shown);
+        m_printer.println("The board of " + std::string{stationName(id)} + " is hidden.");
+    }
+    else {
+        m_boards.emplace_back(m_dispatch, id);
+        m_boards.back().refresh();
+        m_printer.println();
+        m_printer.print(m_boards.back());
+    }
+    waitForEnter();
+}
+
+void App::printDepartureBoards()
+{
+    for (auto& b: m_boards) {
+        b.refresh();
+        m_printer.println();
+        m_printer.print(b);
+    }
+}
+
 void App::showVehicleById()
 {
     clearScreen();
@@ -358,8 +673,7 @@ void App::showVehicleHistory(const int carId)
 {
     m_printer.println("Travel history (arrivals):");
     try {
-        const auto history = m_carLog.viewRecordOf(carId);
-        for (const auto& record: history) {
+        for (const auto& record: m_carLog.viewRecordOf(carId)) {
             m_printer.print(record);
         }
     }
@@ -375,7 +689,7 @@ void App::printStatistics()
     m_printer.println("-----------------------------------------");
     for (const auto& station: m_initialStationStates) {
         const auto vehicleCount = std::to_string(station.carCount());
-        m_printer.println(station.name() + " = "s + vehicleCount);
+        m_printer.println(std::string{station.name()} + " = "s + vehicleCount);
     }
     m_printer.println();
 
@@ -390,6 +704,25 @@ void App::printStatistics()
     IO::println(m_sim.currentTime());
     m_printer.println();
 
+    m_printer.println("Platform utilization:");
+    m_printer.println("--------------------");
+    const auto begin = m_sim.startTime().rawTime();
+    const auto end = m_sim.currentTime().rawTime();
+    for (const auto id: m_dispatch.stationIds()) {
+        const auto& platforms = m_dispatch.viewStation(id).platforms();
+        auto line = std::ostringstream{};
+        line << std::fixed << std::setprecision(1) << stationName(id)
+             << " = at most " << platforms.peak() << " trains, "
+             << platforms.averageOccupied(begin, end) << " on average";
+        if (platforms.isLimited()) {
+            line << " on " << platforms.platforms() << " platforms ("
+                 << 100.0 * platforms.averageOccupied(begin, end) / platforms.platforms()
+                 << "%)";
+        }
+        m_printer.println(line.str());
+    }
+    m_printer.println();
+
 
     m_printer.println("Trains that never left the station: ");
     m_printer.println("----------------------------------");
@@ -413,6 +746,14 @@ void App::printStatistics()
 
 void App::writeLogToFile()
 {
+    m_log.clearSinks();
+    if (m_trace) {
+        finishEventTrace();
+    }
+    if (m_logStream) {
+        finishLogStream();
+        return;
+    }
     using namespace std::string_literals;
     const auto filename = "Trainsim.log"s;
     auto file = std::ofstream(filename);
@@ -433,4 +774,184 @@ void App::writeLogToFile()
     println("\nWrote log to "s + filename);
 }
 
+void App::setLogStreaming()
+{
+    const auto window = get<int>("Records kept in memory while streaming "
+                                 "the log (0 = no streaming): ");
+    if (window < 0) {
+        throw std::out_of_range("The number of records must not be negative!");
+    }
+    m_streamWindow = static_cast<std::size_t>(window);
+}
+
+void App::printLogStreaming()
+{
+    print("Log streaming: ");
+    if (m_streamWindow == 0) {
+        println("off");
+        return;
+    }
+    println("on, keeping " + std::to_string(m_streamWindow) + " records");
+}
+
+void App::startLogStream()
+{
+    using namespace std::string_literals;
+    const auto filename = "Trainsim.log"s;
+    m_logFile = std::ofstream(filename);
+    if (!m_logFile) {
+        throw std::runtime_error("Could not write to " + filename);
+    }
+    m_logFile << m_sim.startTime().asString() << ": STARTING SIMULATION\n";
+
+    m_logStream = std::make_unique<train::LogStream>(m_logFile, m_printer);
+    m_log.setWindow(m_streamWindow);
+    m_log.addSink([stream = m_logStream.get()](const train::TrainRecord& tr) {
+        stream->write(tr);
+    });
+}
+
+void App::finishLogStream()
+{
+    auto stream = std::move(m_logStream);
+    stream->finish();
+    m_logFile << '\n' << m_sim.currentTime().asString() << ": ENDING SIMULATION\n";
+    m_logFile.close();
+
+    using namespace std::string_literals;
+    println("\nWrote log to Trainsim.log"s);
+}
+
+void App::toggleEventTrace()
+{
+    m_traceEnabled = !m_traceEnabled;
+}
+
+void App::printEventTrace()
+{
+    print("Event trace: ");
+    println(m_traceEnabled ? "on" : "off");
+}
+
+void App::setAllocationPolicy()
+{
+    const auto names = allocationPolicyNames();
+    for (auto i = std::size_t{0}; i < names.size(); ++i) {
+        println(std::to_string(i + 1) + ". " + names[i]);
+    }
+    const auto choice = get<int>("> ");
+    if (choice < 1 || static_cast<std::size_t>(choice) > names.size()) {
+        throw std::out_of_range("Not a valid allocation policy!");
+    }
+    auto config = m_sim.config();
+    config.allocation = makeAllocationPolicy(names[choice - 1]);
+    m_sim.setConfig(std::move(config));
+}
+
+void App::printAllocationPolicy()
+{
+    println("Car allocation: " + m_sim.config().allocation->name());
+}
+
+void App::toggleRepositioning()
+{
+    auto config = m_sim.config();
+    config.repositioning = !config.repositioning;
+    m_sim.setConfig(std::move(config));
+}
+
+void App::printRepositioning()
+{
+    print("Car repositioning: ");
+    println(m_sim.config().repositioning ? "on" : "off");
+}
+
+void App::setTracksPerPath()
+{
+    auto config = m_sim.config();
+    config.tracksPerPath = get<int>("Enter tracks per path (0 for no limit): ");
+    m_sim.setConfig(std::move(config));
+}
+
+void App::printTracksPerPath()
+{
+    const auto tracks = m_sim.config().tracksPerPath;
+    println("Tracks per path: " + (tracks > 0 ? std::to_string(tracks) : "no limit"s));
+}
+
+void App::toggleEventMetrics()
+{
+    m_metricsEnabled = !m_metricsEnabled;
+}
+
+void App::printEventMetricsSetting()
+{
+    print("Event metrics: ");
+    println(m_metricsEnabled ? "on" : "off");
+}
+
+void App::showEventMetrics()
+{
+    clearScreen();
+    if (!m_metrics) {
+        m_printer.println("Event metrics are off, turn them on in the start menu.");
+    }
+    else {
+        auto report = std::ostringstream{};
+        report << *m_metrics;
+        m_printer.print(report.str());
+    }
+    waitForEnter();
+}
+
+void App::writeEventMetrics()
+{
+    using namespace std::string_literals;
+    const auto filename = "Metrics.txt"s;
+    auto file = std::ofstream(filename);
+    if (!file) {
+        throw std::runtime_error("Could not write to " + filename);
+    }
+    file << *m_metrics;
+    println("Wrote event metrics to "s + filename);
+}
+
+#ifdef PABO_TRACING
+void App::writeScopeTrace()
+{
+    using namespace std::string_literals;
+    const auto filename = "Trainsim.json"s;
+    auto file = std::ofstream(filename);
+    if (!file) {
+        throw std::runtime_error("Could not write to " + filename);
+    }
+    writeScopeTraces(file);
+    println("Wrote scope trace to "s + filename);
+}
+#endif
+
+void App::startEventTrace()
+{
+    using namespace std::string_literals;
+    const auto filename = "Trainsim.trace"s;
+    m_traceFile = std::ofstream(filename, std::ios::binary);
+    if (!m_traceFile) {
+        throw std::runtime_error("Could not write to " + filename);
+    }
+    m_trace = std::make_unique<train::TraceWriter>(m_traceFile, m_dispatch.stationNames());
+    m_log.addSink([trace = m_trace.get()](const train::TrainRecord& tr) {
+        trace->write(tr);
+    });
+}
+
+void App::finishEventTrace()
+{
+    auto trace = std::move(m_trace);
+    trace->finish();
+    m_traceFile.close();
+
+    using namespace std::string_literals;
+    println("\nWrote event trace to Trainsim.trace"s);
+}
+
 };  // namespace pabo::app
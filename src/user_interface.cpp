@@ -36,6 +36,42 @@ void UserInterface::setUpStartMenu()
         disableStatOptions();
         runSimulationMenu();
     });
+
+    startMenu.addItem("Run parameter sweep", [this]() {
+        app.runParameterSweep();
+    });
+
+    startMenu.addItem("Run scenario batch", [this]() {
+        app.runScenarioBatch();
+    });
+
+    startMenu.addItem("Change execution mode", [this]() {
+        app.setExecutionMode();
+    });
+
+    startMenu.addItem("Change log streaming", [this]() {
+        app.setLogStreaming();
+    });
+
+    startMenu.addItem("Toggle event trace", [this]() {
+        app.toggleEventTrace();
+    });
+
+    startMenu.addItem("Toggle event metrics", [this]() {
+        app.toggleEventMetrics();
+    });
+
+    startMenu.addItem("Change car allocation", [this]() {
+        app.setAllocationPolicy();
+    });
+
+    startMenu.addItem("Toggle car repositioning", [this]() {
+        app.toggleRepositioning();
+    });
+
+    startMenu.addItem("Change tracks per path", [this]() {
+        app.setTracksPerPath();
+    });
 }
 
 void UserInterface::runSimulationMenu()
@@ -57,6 +93,7 @@ void UserInterface::runSimMenuOnce()
     clearScreen();
     app.printInterval();
     app.printCurrentTime();
+    app.printProgress();
     app.printCurrentLogLevel();
 
     simMenu.runOnce();
@@ -117,6 +154,10 @@ void UserInterface::setUpSimMenu()
             },
             false);
 
+    simMenu.addItem("Show event metrics", [this]() {
+        app.showEventMetrics();
+    });
+
     simMenu.addItem("Change log level", [this]() {
         app.setLogLevel();
     });
@@ -167,6 +208,14 @@ void UserInterface::setUpStnMenu()
         app.showAllStations();
     });
 
+    stnMenu.addItem("Show station timetable", [this]() {
+        app.showStationTimetable();
+    });
+
+    stnMenu.addItem("Toggle departure board", [this]() {
+        app.toggleDepartureBoard();
+    });
+
     stnMenu.addItem("Change log level", [this]() {
         app.setLogLevel();
     });
@@ -209,6 +258,13 @@ void UserInterface::runStartMenuOnce()
 {
     clearScreen();
     app.printStartAndEndTimes();
+    app.printExecutionMode();
+    app.printLogStreaming();
+    app.printEventTrace();
+    app.printEventMetricsSetting();
+    app.printAllocationPolicy();
+    app.printRepositioning();
+    app.printTracksPerPath();
     println("");
 
     startMenu.runOnce();